@@ -15,6 +15,7 @@
 #  ifdef _WIN32
 #    include <io.h>
 #    include <direct.h>
+#    include <process.h>
 
 //
 // Microsoft renames the POSIX functions to _name, and introduces
@@ -29,6 +30,7 @@
 #    define access	_access
 #    define close	_close
 #    define fileno	_fileno
+#    define getpid	_getpid
 #    define lseek	_lseek
 #    define mkdir(d,p)	_mkdir(d)
 #    define open	_open
@@ -50,10 +52,63 @@
 #    define O_RDONLY	_O_RDONLY
 #    define O_WRONLY	_O_WRONLY
 #    define O_CREAT	_O_CREAT
+#    define O_EXCL	_O_EXCL
+#    define O_BINARY	_O_BINARY
 #    define O_TRUNC	_O_TRUNC
 
 #  else
 #    include <unistd.h>
+#    ifndef O_BINARY
+#      define O_BINARY	0		// No text/binary distinction on POSIX
+#    endif // !O_BINARY
+#  endif // _WIN32
+
+
+//
+// Threading primitives used by shared memory pools.  Without threading
+// support, `hcPoolNewShared` fails and the primitives do nothing...
+//
+
+#  ifdef _WIN32
+#    include <windows.h>
+
+typedef CRITICAL_SECTION _hc_mutex_t;	// Mutual exclusion lock
+typedef DWORD _hc_key_t;		// Thread-specific data key
+
+#    define _hcKeyCreate(k,d)	((*(k) = FlsAlloc((PFLS_CALLBACK_FUNCTION)(d))) != FLS_OUT_OF_INDEXES)
+#    define _hcKeyDelete(k)	FlsFree(k)
+#    define _hcKeyGet(k)	FlsGetValue(k)
+#    define _hcKeySet(k,v)	FlsSetValue(k, v)
+#    define _hcMutexDestroy(m)	DeleteCriticalSection(m)
+#    define _hcMutexInit(m)	InitializeCriticalSection(m)
+#    define _hcMutexLock(m)	EnterCriticalSection(m)
+#    define _hcMutexUnlock(m)	LeaveCriticalSection(m)
+#  elif defined(HAVE_PTHREAD_H)
+#    include <pthread.h>
+
+typedef pthread_mutex_t _hc_mutex_t;	// Mutual exclusion lock
+typedef pthread_key_t _hc_key_t;	// Thread-specific data key
+
+#    define _hcKeyCreate(k,d)	(pthread_key_create(k, d) == 0)
+#    define _hcKeyDelete(k)	pthread_key_delete(k)
+#    define _hcKeyGet(k)	pthread_getspecific(k)
+#    define _hcKeySet(k,v)	pthread_setspecific(k, v)
+#    define _hcMutexDestroy(m)	pthread_mutex_destroy(m)
+#    define _hcMutexInit(m)	pthread_mutex_init(m, NULL)
+#    define _hcMutexLock(m)	pthread_mutex_lock(m)
+#    define _hcMutexUnlock(m)	pthread_mutex_unlock(m)
+#  else
+typedef int _hc_mutex_t;		// Mutual exclusion lock (unused)
+typedef int _hc_key_t;			// Thread-specific data key (unused)
+
+#    define _hcKeyCreate(k,d)	(*(k) = 0, false)
+#    define _hcKeyDelete(k)	(void)(k)
+#    define _hcKeyGet(k)	NULL
+#    define _hcKeySet(k,v)	(void)(v)
+#    define _hcMutexDestroy(m)	(void)(m)
+#    define _hcMutexInit(m)	(void)(m)
+#    define _hcMutexLock(m)	(void)(m)
+#    define _hcMutexUnlock(m)	(void)(m)
 #  endif // _WIN32
 
 
@@ -47,6 +47,7 @@ static bool		hc_get_color(hc_pool_t *pool, const char *value, hc_color_t *color)
 static float		hc_get_length(hc_pool_t *pool, const char *value, float max_value, float multiplier, hc_css_t *css, hc_text_t *text);
 static int		hc_match_node(hc_node_t *node, _hc_css_sel_t *sel, const char *pseudo_class);
 static int		hc_match_rule(hc_node_t *node, _hc_rule_t *rule, const char *pseudo_class);
+static bool		hc_match_string(bool pooled, const char *a, const char *b);
 static double		hc_strtod(hc_pool_t *pool, const char *s, char **end);
 
 
@@ -178,7 +179,8 @@ hcNodeComputeCSSBox(
   // Background values (just a single background image is currently supported)
   if ((value = hcDictGetKeyValue(props, "background")) != NULL)
   {
-    char	*temp = strdup(value),	// Temporary copy of value
+    char	*temp = _hcPoolStrdup(pool, value),
+					// Temporary copy of value
 		*current,		// Current value
 		*next;			// Next value
     int		first_box = 1,		// First box value?
@@ -274,7 +276,7 @@ hcNodeComputeCSSBox(
       }
     }
 
-    free(temp);
+    _hcPoolFree(pool, temp);
   }
 
   if ((value = hcDictGetKeyValue(props, "background-attachment")) != NULL)
@@ -324,7 +326,8 @@ hcNodeComputeCSSBox(
 
   if ((value = hcDictGetKeyValue(props, "background-position")) != NULL)
   {
-    char	*temp = strdup(value),	// Temporary copy of value
+    char	*temp = _hcPoolStrdup(pool, value),
+					// Temporary copy of value
 		*current,		// Current value
 		*next;			// Next value
     int		pos_size = 0;		// X/Y position/size
@@ -357,7 +360,7 @@ hcNodeComputeCSSBox(
       }
     }
 
-    free(temp);
+    _hcPoolFree(pool, temp);
   }
 
   if ((value = hcDictGetKeyValue(props, "background-repeat")) != NULL)
@@ -374,7 +377,8 @@ hcNodeComputeCSSBox(
 
   if ((value = hcDictGetKeyValue(props, "background-size")) != NULL)
   {
-    char	*temp = strdup(value),	// Temporary copy of value
+    char	*temp = _hcPoolStrdup(pool, value),
+					// Temporary copy of value
 		*current,		// Current value
 		*next;			// Next value
     int		pos_size = 2;		// X/Y position/size
@@ -404,7 +408,7 @@ hcNodeComputeCSSBox(
       }
     }
 
-    free(temp);
+    _hcPoolFree(pool, temp);
   }
 
   if (box->background_image)
@@ -511,7 +515,8 @@ hcNodeComputeCSSBox(
   // Border values...
   if ((value = hcDictGetKeyValue(props, "border")) != NULL)
   {
-    char	*temp = strdup(value),	// Temporary copy of value
+    char	*temp = _hcPoolStrdup(pool, value),
+					// Temporary copy of value
 		*current,		// Current value
 		*next;			// Next value
 
@@ -550,12 +555,13 @@ hcNodeComputeCSSBox(
       }
     }
 
-    free(temp);
+    _hcPoolFree(pool, temp);
   }
 
   if ((value = hcDictGetKeyValue(props, "border-bottom")) != NULL)
   {
-    char	*temp = strdup(value),	// Temporary copy of value
+    char	*temp = _hcPoolStrdup(pool, value),
+					// Temporary copy of value
 		*current,		// Current value
 		*next;			// Next value
 
@@ -594,12 +600,13 @@ hcNodeComputeCSSBox(
       }
     }
 
-    free(temp);
+    _hcPoolFree(pool, temp);
   }
 
   if ((value = hcDictGetKeyValue(props, "border-left")) != NULL)
   {
-    char	*temp = strdup(value),	// Temporary copy of value
+    char	*temp = _hcPoolStrdup(pool, value),
+					// Temporary copy of value
 		*current,		// Current value
 		*next;			// Next value
 
@@ -638,12 +645,13 @@ hcNodeComputeCSSBox(
       }
     }
 
-    free(temp);
+    _hcPoolFree(pool, temp);
   }
 
   if ((value = hcDictGetKeyValue(props, "border-right")) != NULL)
   {
-    char	*temp = strdup(value),	// Temporary copy of value
+    char	*temp = _hcPoolStrdup(pool, value),
+					// Temporary copy of value
 		*current,		// Current value
 		*next;			// Next value
 
@@ -682,12 +690,13 @@ hcNodeComputeCSSBox(
       }
     }
 
-    free(temp);
+    _hcPoolFree(pool, temp);
   }
 
   if ((value = hcDictGetKeyValue(props, "border-top")) != NULL)
   {
-    char	*temp = strdup(value),	// Temporary copy of value
+    char	*temp = _hcPoolStrdup(pool, value),
+					// Temporary copy of value
 		*current,		// Current value
 		*next;			// Next value
 
@@ -726,7 +735,7 @@ hcNodeComputeCSSBox(
       }
     }
 
-    free(temp);
+    _hcPoolFree(pool, temp);
   }
 
   if ((value = hcDictGetKeyValue(props, "border-color")) != NULL)
@@ -869,7 +878,8 @@ hcNodeComputeCSSBox(
 
   if ((value = hcDictGetKeyValue(props, "border-image")) != NULL)
   {
-    char	*temp = strdup(value),	// Temporary copy of value
+    char	*temp = _hcPoolStrdup(pool, value),
+					// Temporary copy of value
 		*current,		// Current value
 		*next;			// Next value
     int		pos = 0;		// Current position
@@ -964,12 +974,13 @@ hcNodeComputeCSSBox(
       }
     }
 
-    free(temp);
+    _hcPoolFree(pool, temp);
   }
 
   if ((value = hcDictGetKeyValue(props, "border-image-outset")) != NULL)
   {
-    char	*temp = strdup(value),	// Temporary copy of value
+    char	*temp = _hcPoolStrdup(pool, value),
+					// Temporary copy of value
 		*current,		// Current value
 		*next;			// Next value
     int		pos = 0;		// Current position
@@ -1005,12 +1016,13 @@ hcNodeComputeCSSBox(
       }
     }
 
-    free(temp);
+    _hcPoolFree(pool, temp);
   }
 
   if ((value = hcDictGetKeyValue(props, "border-image-repeat")) != NULL)
   {
-    char	*temp = strdup(value),	// Temporary copy of value
+    char	*temp = _hcPoolStrdup(pool, value),
+					// Temporary copy of value
 		*current,		// Current value
 		*next;			// Next value
     int		pos = 0;		// Current position
@@ -1031,12 +1043,13 @@ hcNodeComputeCSSBox(
       }
     }
 
-    free(temp);
+    _hcPoolFree(pool, temp);
   }
 
   if ((value = hcDictGetKeyValue(props, "border-image-slice")) != NULL)
   {
-    char	*temp = strdup(value),	// Temporary copy of value
+    char	*temp = _hcPoolStrdup(pool, value),
+					// Temporary copy of value
 		*current,		// Current value
 		*next;			// Next value
     int		pos = 0;		// Current position
@@ -1072,7 +1085,7 @@ hcNodeComputeCSSBox(
       }
     }
 
-    free(temp);
+    _hcPoolFree(pool, temp);
   }
 
   if ((value = hcDictGetKeyValue(props, "border-image-source")) != NULL)
@@ -1088,7 +1101,8 @@ hcNodeComputeCSSBox(
 
   if ((value = hcDictGetKeyValue(props, "border-image-width")) != NULL)
   {
-    char	*temp = strdup(value),	// Temporary copy of value
+    char	*temp = _hcPoolStrdup(pool, value),
+					// Temporary copy of value
 		*current,		// Current value
 		*next;			// Next value
     int		pos = 0;		// Current position
@@ -1124,12 +1138,13 @@ hcNodeComputeCSSBox(
       }
     }
 
-    free(temp);
+    _hcPoolFree(pool, temp);
   }
 
   if ((value = hcDictGetKeyValue(props, "border-radius")) != NULL)
   {
-    char	*temp = strdup(value),	// Temporary copy of value
+    char	*temp = _hcPoolStrdup(pool, value),
+					// Temporary copy of value
 		*current,		// Current value
 		*next;			// Next value
     int		pos = 0;		// Position
@@ -1197,12 +1212,13 @@ hcNodeComputeCSSBox(
       }
     }
 
-    free(temp);
+    _hcPoolFree(pool, temp);
   }
 
   if ((value = hcDictGetKeyValue(props, "border-bottom-left-radius")) != NULL)
   {
-    char	*temp = strdup(value),	// Temporary copy of value
+    char	*temp = _hcPoolStrdup(pool, value),
+					// Temporary copy of value
 		*current,		// Current value
 		*next;			// Next value
     int		pos = 0;		// Position
@@ -1229,12 +1245,13 @@ hcNodeComputeCSSBox(
       }
     }
 
-    free(temp);
+    _hcPoolFree(pool, temp);
   }
 
   if ((value = hcDictGetKeyValue(props, "border-bottom-right-radius")) != NULL)
   {
-    char	*temp = strdup(value),	// Temporary copy of value
+    char	*temp = _hcPoolStrdup(pool, value),
+					// Temporary copy of value
 		*current,		// Current value
 		*next;			// Next value
     int		pos = 0;		// Position
@@ -1261,12 +1278,13 @@ hcNodeComputeCSSBox(
       }
     }
 
-    free(temp);
+    _hcPoolFree(pool, temp);
   }
 
   if ((value = hcDictGetKeyValue(props, "border-top-left-radius")) != NULL)
   {
-    char	*temp = strdup(value),	// Temporary copy of value
+    char	*temp = _hcPoolStrdup(pool, value),
+					// Temporary copy of value
 		*current,		// Current value
 		*next;			// Next value
     int		pos = 0;		// Position
@@ -1293,12 +1311,13 @@ hcNodeComputeCSSBox(
       }
     }
 
-    free(temp);
+    _hcPoolFree(pool, temp);
   }
 
   if ((value = hcDictGetKeyValue(props, "border-top-right-radius")) != NULL)
   {
-    char	*temp = strdup(value),	// Temporary copy of value
+    char	*temp = _hcPoolStrdup(pool, value),
+					// Temporary copy of value
 		*current,		// Current value
 		*next;			// Next value
     int		pos = 0;		// Position
@@ -1325,12 +1344,13 @@ hcNodeComputeCSSBox(
       }
     }
 
-    free(temp);
+    _hcPoolFree(pool, temp);
   }
 
   if ((value = hcDictGetKeyValue(props, "border-spacing")) != NULL)
   {
-    char	*temp = strdup(value),	// Temporary copy of value
+    char	*temp = _hcPoolStrdup(pool, value),
+					// Temporary copy of value
 		*current,		// Current value
 		*next;			// Next value
     int		pos = 0;		// Position
@@ -1357,12 +1377,13 @@ hcNodeComputeCSSBox(
       }
     }
 
-    free(temp);
+    _hcPoolFree(pool, temp);
   }
 
   if ((value = hcDictGetKeyValue(props, "box-shadow")) != NULL)
   {
-    char	*temp = strdup(value),	// Temporary copy of value
+    char	*temp = _hcPoolStrdup(pool, value),
+					// Temporary copy of value
 		*current,		// Current value
 		*next;			// Next value
     int		pos = 0;		// Position
@@ -1402,7 +1423,7 @@ hcNodeComputeCSSBox(
       }
     }
 
-    free(temp);
+    _hcPoolFree(pool, temp);
   }
 
   if ((value = hcDictGetKeyValue(props, "break-after")) == NULL)
@@ -1459,7 +1480,8 @@ hcNodeComputeCSSBox(
 
   if ((value = hcDictGetKeyValue(props, "list-style")) != NULL)
   {
-    char	*temp = strdup(value),	// Temporary copy of value
+    char	*temp = _hcPoolStrdup(pool, value),
+					// Temporary copy of value
 		*current,		// Current value
 		*next;			// Next value
 
@@ -1489,7 +1511,7 @@ hcNodeComputeCSSBox(
       }
     }
 
-    free(temp);
+    _hcPoolFree(pool, temp);
   }
 
   if ((value = hcDictGetKeyValue(props, "list-style-image")) != NULL)
@@ -1571,7 +1593,8 @@ hcNodeComputeCSSBox(
 
   if ((value = hcDictGetKeyValue(props, "margin")) != NULL)
   {
-    char	*temp = strdup(value),	// Copy of value
+    char	*temp = _hcPoolStrdup(pool, value),
+					// Copy of value
 		*current,		// Current value
 		*next;			// Next value
     int		num_values = 0;		// Number of values
@@ -1622,7 +1645,7 @@ hcNodeComputeCSSBox(
 	  break;
     }
 
-    free(temp);
+    _hcPoolFree(pool, temp);
   }
 
   if ((value = hcDictGetKeyValue(props, "margin-bottom")) != NULL)
@@ -1659,7 +1682,8 @@ hcNodeComputeCSSBox(
 
   if ((value = hcDictGetKeyValue(props, "padding")) != NULL)
   {
-    char	*temp = strdup(value),	// Copy of value
+    char	*temp = _hcPoolStrdup(pool, value),
+					// Copy of value
 		*current,		// Current value
 		*next;			// Next value
     int		num_values = 0;		// Number of values
@@ -1708,7 +1732,7 @@ hcNodeComputeCSSBox(
 	  break;
     }
 
-    free(temp);
+    _hcPoolFree(pool, temp);
   }
 
   if ((value = hcDictGetKeyValue(props, "padding-bottom")) != NULL)
@@ -1970,7 +1994,8 @@ hcNodeComputeCSSText(
 
   if ((value = hcDictGetKeyValue(props, "quotes")) != NULL)
   {
-    char	*temp = strdup(value),	// Temporary copy of value
+    char	*temp = _hcPoolStrdup(pool, value),
+					// Temporary copy of value
 		*current,		// Current value
 		*next,			// Next value
 		sep;			// Separator character
@@ -2019,7 +2044,7 @@ hcNodeComputeCSSText(
         next ++;
     }
 
-    free(temp);
+    _hcPoolFree(pool, temp);
   }
 
   if ((value = hcDictGetKeyValue(props, "text-align")) != NULL)
@@ -2153,7 +2178,8 @@ _hcNodeComputeCSSTextFont(
 
   if ((value = hcDictGetKeyValue(props, "font")) != NULL)
   {
-    char	*temp = strdup(value),	// Temporary copy of value
+    char	*temp = _hcPoolStrdup(pool, value),
+					// Temporary copy of value
 		*current,		// Current value
 		*next,			// Next value
 		sep;			// Separator character
@@ -2345,7 +2371,7 @@ _hcNodeComputeCSSTextFont(
       font_pos ++;
     }
 
-    free(temp);
+    _hcPoolFree(pool, temp);
   }
 
   if ((value = hcDictGetKeyValue(props, "font-family")) != NULL)
@@ -2487,7 +2513,7 @@ _hcNodeComputeCSSTextFont(
   // Lookup font...
   if (text->font_family)
   {
-    char	*temp = strdup(text->font_family),
+    char	*temp = _hcPoolStrdup(pool, text->font_family),
 					// Temporary copy of value
 		*current,		// Current value
 		*next;			// Next value
@@ -2520,10 +2546,10 @@ _hcNodeComputeCSSTextFont(
       if (*next)
 	*next++ = '\0';
 
-      text->font = ttfCacheFind(pool->fonts, current, text->font_style, text->font_weight, text->font_stretch);
+      text->font = _hcPoolFindFont(pool, current, text->font_style, text->font_weight, text->font_stretch);
     }
 
-    free(temp);
+    _hcPoolFree(pool, temp);
   }
 
   return (true);
@@ -2556,7 +2582,7 @@ hc_create_props(hc_node_t    *node,	// I - HTML node
                 hc_compute_t compute)	// I - Pseudo-class, if any
 {
   hc_dict_t		*props;		// Properties
-  size_t		i, j,		// Looping vars
+  size_t		i,		// Looping var
 			count,		// Number of properties
 			num_matches = 0,// Number of matches
 			alloc_matches = 0;
@@ -2645,9 +2671,9 @@ hc_create_props(hc_node_t    *node,	// I - HTML node
     {
       if (num_matches >= alloc_matches)
       {
-        if ((match = realloc(matches, (alloc_matches + 16) * sizeof(_hc_css_match_t))) == NULL)
+        if ((match = _hcPoolRealloc(css->pool, matches, (alloc_matches + 16) * sizeof(_hc_css_match_t))) == NULL)
 	{
-	  free(matches);
+	  _hcPoolFree(css->pool, matches);
 	  return (NULL);
 	}
 
@@ -2673,9 +2699,9 @@ hc_create_props(hc_node_t    *node,	// I - HTML node
     {
       if (num_matches >= alloc_matches)
       {
-        if ((match = realloc(matches, (alloc_matches + 16) * sizeof(_hc_css_match_t))) == NULL)
+        if ((match = _hcPoolRealloc(css->pool, matches, (alloc_matches + 16) * sizeof(_hc_css_match_t))) == NULL)
 	{
-	  free(matches);
+	  _hcPoolFree(css->pool, matches);
 	  return (NULL);
 	}
 
@@ -2736,29 +2762,25 @@ hc_create_props(hc_node_t    *node,	// I - HTML node
 
   if ((rule = _hcRuleColFindHash(&css->all_rules, hash)) != NULL)
   {
+    _hcPoolFree(css->pool, matches);
     hcDictDelete(props);
     return (rule->props);
   }
 
   // No match, so synthesize the properties and add it...
   for (i = num_matches, match = matches; i > 0; i --, match ++)
-  {
-    hc_dict_t *dict = match->rule->props;
-					// Dictionary for this match
+    hcDictMerge(props, match->rule->props, true);
 
-    for (j = 0, count = hcDictGetCount(dict); j < count; j ++)
-    {
-      value = hcDictGetIndexKeyValue(dict, j, &key);
-
-      hcDictSetKeyValue(props, key, value);
-    }
-  }
+  _hcPoolFree(css->pool, matches);
 
   // Add a rule with this new hash...
-  rule = _hcRuleNew(css, hash, NULL, props);
+  if ((rule = _hcRuleNew(css, hash, NULL, props)) == NULL)
+    return (props);
+
   _hcRuleColAdd(css, &css->all_rules, rule);
+  hcDictDelete(props);
 
-  return (props);
+  return (rule->props);
 }
 
 
@@ -3056,6 +3078,7 @@ hc_match_node(
   size_t	i;			// Looping var
   _hc_css_selstmt_t *stmt;		// Current statement
   const char	*value;			// Value
+  bool		pooled;			// Do the node and selector share a pool?
 
 
   if (node->element != sel->element && sel->element != HC_ELEMENT_WILDCARD)
@@ -3063,6 +3086,10 @@ hc_match_node(
   else if (sel->element != HC_ELEMENT_WILDCARD)
     score ++;
 
+  // Strings interned in the same pool are equal only if their pointers (atoms)
+  // are equal, so we can skip most string comparisons...
+  pooled = node->element >= HC_ELEMENT_DOCTYPE && node->value.element.html->css && node->value.element.html->pool == node->value.element.html->css->pool;
+
   for (i = sel->num_stmts, stmt = sel->stmts; i > 0; i--, stmt ++)
   {
     switch (stmt->match)
@@ -3074,7 +3101,7 @@ hc_match_node(
 	  score += 100;
           break;
       case _HC_MATCH_ATTR_EQUALS :
-          if ((value = hcNodeAttrGetNameValue(node, stmt->name)) == NULL || strcmp(value, stmt->value))
+          if ((value = hcNodeAttrGetNameValue(node, stmt->name)) == NULL || !hc_match_string(pooled, value, stmt->value))
             return (-1);
 
 	  score += 100;
@@ -3126,13 +3153,13 @@ hc_match_node(
           }
           break;
       case _HC_MATCH_CLASS :
-          if ((value = hcNodeAttrGetNameValue(node, "class")) == NULL || strcmp(value, stmt->name))
+          if ((value = hcNodeAttrGetNameValue(node, "class")) == NULL || !hc_match_string(pooled, value, stmt->name))
             return (-1);
 
 	  score += 100;
           break;
       case _HC_MATCH_ID :
-          if ((value = hcNodeAttrGetNameValue(node, "id")) == NULL || strcmp(value, stmt->name))
+          if ((value = hcNodeAttrGetNameValue(node, "id")) == NULL || !hc_match_string(pooled, value, stmt->name))
             return (-1);
 
 	  score += 10000;
@@ -3334,6 +3361,29 @@ hc_match_rule(hc_node_t  *node,		// I  - HTML node
 }
 
 
+//
+// 'hc_match_string()' - Compare a node value with a selector value.
+//
+// Non-empty strings in dictionaries and selectors are always interned, so when
+// the node and selector share a pool they are equal only if their pointers are
+// equal.  Empty strings need not come from the pool and are compared using
+// `strcmp`, as are strings from different pools.
+//
+
+static bool				// O - `true` if equal, `false` otherwise
+hc_match_string(bool       pooled,	// I - Do the strings share a pool?
+                const char *a,		// I - First string
+                const char *b)		// I - Second string
+{
+  if (a == b)
+    return (true);
+  else if (pooled && *a && *b)
+    return (false);
+  else
+    return (!strcmp(a, b));
+}
+
+
 //
 // 'hc_strtod()' - Convert a string to a double without respect to the locale.
 //
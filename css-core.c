@@ -10,7 +10,7 @@
 //
 
 #  include "css-private.h"
-#  include "pool.h"
+#  include "pool-private.h"
 
 
 //
@@ -26,11 +26,13 @@ hcCSSDelete(hc_css_t *css)		// I - Stylesheet
   if (!css)
     return;
 
+  _hcPoolRemoveCSS(css->pool, css);
+
   for (element = HC_ELEMENT_WILDCARD; element < HC_ELEMENT_MAX; element ++)
-    _hcRuleColClear(css->rules + element, 0);
-  _hcRuleColClear(&css->all_rules, 1);
+    _hcRuleColClear(css, css->rules + element, 0);
+  _hcRuleColClear(css, &css->all_rules, 1);
 
-  free(css);
+  _hcPoolFree(css->pool, css);
 }
 
 
@@ -41,7 +43,7 @@ hcCSSDelete(hc_css_t *css)		// I - Stylesheet
 hc_css_t *				// O - Stylesheet
 hcCSSNew(hc_pool_t *pool)		// I - Memory pool
 {
-  hc_css_t	*css = (hc_css_t *)calloc(1, sizeof(hc_css_t));
+  hc_css_t	*css = (hc_css_t *)_hcPoolCalloc(pool, 1, sizeof(hc_css_t));
 					// Stylesheet
 
 
@@ -51,6 +53,8 @@ hcCSSNew(hc_pool_t *pool)		// I - Memory pool
     // ISO A4) at 128ppi.
     css->pool = pool;
 
+    _hcPoolAddCSS(pool, css);
+
     hcCSSSetMedia(css, "print", 24, 8, 1058.27f, 1408.0f);
   }
 
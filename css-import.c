@@ -58,7 +58,7 @@ static int		hc_eval_media(hc_css_t *css, hc_file_t *file, _hc_type_t *type, char
 static char		*hc_read(hc_file_t *file, _hc_type_t *type, char *buffer, size_t bufsize);
 static hc_dict_t	*hc_read_props(hc_css_t *css, hc_file_t *file, hc_dict_t *props);
 static _hc_css_sel_t	*hc_read_sel(hc_css_t *css, hc_file_t *file, _hc_type_t *type, char *buffer, size_t bufsize);
-static char		*hc_read_value(hc_file_t *file, char *buffer, size_t bufsize);
+static const char	*hc_read_value(hc_file_t *file, char *buffer, size_t bufsize, size_t *length);
 
 
 //
@@ -90,7 +90,7 @@ hcCSSImport(hc_css_t  *css,		// I - Stylesheet
   // Read CSS...
   while (hc_read(file, &type, buffer, sizeof(buffer)))
   {
-    _HC_DEBUG("%s:%d: %s %s\n", file->url, file->linenum, types[type], buffer);
+    _HC_DEBUG("%s:%d: %s %s\n", file->url, _hcFileGetLine(file), types[type], buffer);
 
     if (!strcmp(buffer, "@import"))
     {
@@ -191,14 +191,14 @@ hcCSSImport(hc_css_t  *css,		// I - Stylesheet
         {
 	  if (skip)
 	  {
-	    _HC_DEBUG("%s:%d: Skipping %d properties for %d selectors.\n", file->url, file->linenum, (int)hcDictGetCount(props), num_sels);
+	    _HC_DEBUG("%s:%d: Skipping %d properties for %d selectors.\n", file->url, _hcFileGetLine(file), (int)hcDictGetCount(props), num_sels);
 
 	    for (i = 0; i < num_sels; i ++)
-	      _hcCSSSelDelete(sels[i]);
+	      _hcCSSSelDelete(css, sels[i]);
 	  }
 	  else
 	  {
-	    _HC_DEBUG("%s:%d: Adding %d properties for %d selectors.\n", file->url, file->linenum, (int)hcDictGetCount(props), num_sels);
+	    _HC_DEBUG("%s:%d: Adding %d properties for %d selectors.\n", file->url, _hcFileGetLine(file), (int)hcDictGetCount(props), num_sels);
 
 	    for (i = 0; i < num_sels; i ++)
 	      hc_add_rule(css, sels[i], props);
@@ -433,7 +433,7 @@ hc_read(hc_file_t  *file,		// I - CSS file
 
   for (;;)
   {
-    while ((ch = hcFileGetc(file)) != EOF)
+    while ((ch = _hcFileGetc(file)) != EOF)
     {
       if (!isspace(ch & 255))
 	break;
@@ -450,24 +450,35 @@ hc_read(hc_file_t  *file,		// I - CSS file
 
       if (ch == ':')
       {
-        if ((ch = hcFileGetc(file)) == ':')
+        if ((ch = _hcFileGetc(file)) == ':')
           *bufptr++ = (char)ch;
         else
-	  hcFileUngetc(file, ch);
+	  _hcFileUngetc(file, ch);
       }
     }
     else if (ch == '\'' || ch == '\"')
     {
       // Quoted string...
-      int quote = ch;			// Quote character
+      int	quote = ch;		// Quote character
+      const char *data;			// String data
+      size_t	datalen;		// Length of string data
 
-      while ((ch = hcFileGetc(file)) != EOF)
+      while ((ch = _hcFileGetc(file)) != EOF)
       {
 	if (ch == quote)
 	  break;
 
 	if (bufptr < bufend)
+	{
 	  *bufptr++ = (char)ch;
+	  datalen   = (size_t)(bufend - bufptr);
+
+	  if (hcFileScan(file, quote == '\'' ? "'" : "\"", &data, &datalen) && datalen > 0)
+	  {
+	    memcpy(bufptr, data, datalen);
+	    bufptr += datalen;
+	  }
+	}
 	else
 	  break;
       }
@@ -490,12 +501,26 @@ hc_read(hc_file_t  *file,		// I - CSS file
 
 	  bufptr --;
 
-	  while ((ch = hcFileGetc(file)) != EOF)
+	  while ((ch = _hcFileGetc(file)) != EOF)
 	  {
+	    const char	*data;		// Skipped data
+	    size_t	datalen = (size_t)-1;
+					// Length of skipped data
+
 	    if (ch == '/' && asterisk)
+	    {
 	      break;
+	    }
+	    else if (ch == '*')
+	    {
+	      asterisk = 1;
+	    }
 	    else
-	      asterisk = ch == '*';
+	    {
+	      // Skip ahead to the next asterisk...
+	      asterisk = 0;
+	      hcFileScan(file, "*", &data, &datalen);
+	    }
 	  }
 
 	  if (bufptr == buffer)
@@ -528,17 +553,17 @@ hc_read(hc_file_t  *file,		// I - CSS file
           }
 
           // Return FOO and save "=" for later...
-          hcFileUngetc(file, '=');
+          _hcFileUngetc(file, '=');
           bufptr --;
           break;
         }
       }
-      while ((ch = hcFileGetc(file)) != EOF);
+      while ((ch = _hcFileGetc(file)) != EOF);
 
       if (bufptr == buffer)
         continue;
       else if (ch != EOF && !isspace(ch & 255) && ch != '(' && ch != '=')
-	hcFileUngetc(file, ch);
+	_hcFileUngetc(file, ch);
 
       if (isdigit(*buffer & 255) || (*buffer == '.' && bufptr > (buffer + 1) && isdigit(buffer[1] & 255)))
         *type = _HC_TYPE_NUMBER;
@@ -567,28 +592,27 @@ hc_read_props(hc_css_t  *css,		// I - Stylesheet
   _hc_type_t	type;			// String type
   char		buffer[256],		// String buffer
 		name[256],		// Name string
-		value[2048];		// Value string
+		value[2048];		// Value buffer
+  const char	*valptr;		// Value string
+  size_t	valuelen;		// Length of value string
   int		skip_remainder = 0;	// Skip the remainder?
 
 
-  while (hc_read(file, &type, buffer, sizeof(buffer)))
+  while (hc_read(file, &type, name, sizeof(name)))
   {
-    _HC_DEBUG("%s:%d: (PROPS) %s %s\n", file->url, file->linenum, types[type], buffer);
+    _HC_DEBUG("%s:%d: (PROPS) %s %s\n", file->url, _hcFileGetLine(file), types[type], name);
 
-    if (type == _HC_TYPE_RESERVED && !strcmp(buffer, "}"))
+    if (type == _HC_TYPE_RESERVED && !strcmp(name, "}"))
       break;
     else if (skip_remainder)
       continue;
     else if (type != _HC_TYPE_STRING)
     {
-      _hcFileError(file, "Unexpected %s seen.", buffer);
+      _hcFileError(file, "Unexpected %s seen.", name);
       skip_remainder = 1;
       continue;
     }
 
-    strncpy(name, buffer, sizeof(name) - 1);
-    name[sizeof(name) - 1] = '\0';
-
     if (!hc_read(file, &type, buffer, sizeof(buffer)) || type != _HC_TYPE_RESERVED || strcmp(buffer, ":"))
     {
       _hcFileError(file, "Missing colon, saw %s instead.", buffer);
@@ -596,7 +620,7 @@ hc_read_props(hc_css_t  *css,		// I - Stylesheet
       continue;
     }
 
-    if (!hc_read_value(file, value, sizeof(value)))
+    if ((valptr = hc_read_value(file, value, sizeof(value), &valuelen)) == NULL)
     {
       _hcFileError(file, "Missing property value.");
       break;
@@ -612,11 +636,11 @@ hc_read_props(hc_css_t  *css,		// I - Stylesheet
     if (!props)
       props = hcDictNew(css->pool);
 
-    _HC_DEBUG("%s:%d: (PROPS) Adding '%s: %s;'.\n", file->url, file->linenum, name, value);
-    hcDictSetKeyValue(props, name, value);
+    _HC_DEBUG("%s:%d: (PROPS) Adding '%s: %.*s;'.\n", file->url, _hcFileGetLine(file), name, (int)valuelen, valptr);
+    hcDictSetKeyValueLen(props, name, strlen(name), valptr, valuelen);
   }
 
-  _HC_DEBUG("%s:%d: (PROPS) Returning %d properties.\n", file->url, file->linenum, (int)hcDictGetCount(props));
+  _HC_DEBUG("%s:%d: (PROPS) Returning %d properties.\n", file->url, _hcFileGetLine(file), (int)hcDictGetCount(props));
 
   return (props);
 }
@@ -646,7 +670,7 @@ hc_read_sel(hc_css_t   *css,		// I  - Stylesheet
 
   do
   {
-    _HC_DEBUG("%s:%d: (SELECTOR) %s %s\n", file->url, file->linenum, types[*type], buffer);
+    _HC_DEBUG("%s:%d: (SELECTOR) %s %s\n", file->url, _hcFileGetLine(file), types[*type], buffer);
 
     if (!strcmp(buffer, ":"))
     {
@@ -727,7 +751,7 @@ hc_read_sel(hc_css_t   *css,		// I  - Stylesheet
         goto error;
       }
 
-      _HC_DEBUG("%s:%d: (SELECTOR) Attribute name '%s'.\n", file->url, file->linenum, name);
+      _HC_DEBUG("%s:%d: (SELECTOR) Attribute name '%s'.\n", file->url, _hcFileGetLine(file), name);
 
       if (!hc_read(file, type, buffer, bufsize) || *type != _HC_TYPE_RESERVED)
       {
@@ -766,7 +790,7 @@ hc_read_sel(hc_css_t   *css,		// I  - Stylesheet
       else
       {
         // Get value...
-	_HC_DEBUG("%s:%d: (SELECTOR) Operator '%s'.\n", file->url, file->linenum, buffer);
+	_HC_DEBUG("%s:%d: (SELECTOR) Operator '%s'.\n", file->url, _hcFileGetLine(file), buffer);
 
 	if (!hc_read(file, type, value, sizeof(value)) || *type != _HC_TYPE_QSTRING)
 	{
@@ -774,7 +798,7 @@ hc_read_sel(hc_css_t   *css,		// I  - Stylesheet
 	  goto error;
 	}
 
-        _HC_DEBUG("%s:%d: (SELECTOR) Attribute value '%s'.\n", file->url, file->linenum, value);
+        _HC_DEBUG("%s:%d: (SELECTOR) Attribute value '%s'.\n", file->url, _hcFileGetLine(file), value);
 
 	if (!hc_read(file, type, buffer, bufsize) || *type != _HC_TYPE_RESERVED || strcmp(buffer, "]"))
 	{
@@ -818,9 +842,9 @@ hc_read_sel(hc_css_t   *css,		// I  - Stylesheet
 
 #ifdef DEBUG
   if (sel)
-    _HC_DEBUG("%s:%d: (SELECTOR) %s (%d matching statements)\n", file->url, file->linenum, hcElementString(sel->element), (int)sel->num_stmts);
+    _HC_DEBUG("%s:%d: (SELECTOR) %s (%d matching statements)\n", file->url, _hcFileGetLine(file), hcElementString(sel->element), (int)sel->num_stmts);
   else
-    _HC_DEBUG("%s:%d: (SELECTOR) NULL\n", file->url, file->linenum);
+    _HC_DEBUG("%s:%d: (SELECTOR) NULL\n", file->url, _hcFileGetLine(file));
 #endif // DEBUG
 
   return (sel);
@@ -828,7 +852,7 @@ hc_read_sel(hc_css_t   *css,		// I  - Stylesheet
   // If we get here there was a hard error...
   error:
 
-  _hcCSSSelDelete(sel);
+  _hcCSSSelDelete(css, sel);
 
   return (NULL);
 }
@@ -837,31 +861,65 @@ hc_read_sel(hc_css_t   *css,		// I  - Stylesheet
 //
 // 'hc_read_value()' - Read a value string.
 //
+// Values without parentheses, quotes, or escapes are returned directly from
+// the file buffer when the terminating ';' or '}' is in the same buffer, so
+// the value remains valid while the ';' is read.  Other values are copied to
+// the string buffer.
+//
 
-static char *				// O - String or `NULL` on error
+static const char *			// O - Value string or `NULL` on error
 hc_read_value(hc_file_t *file,		// I - File to read from
               char      *buffer,	// I - String buffer
-              size_t    bufsize)	// I - Size of string buffer
+              size_t    bufsize,	// I - Size of string buffer
+              size_t    *length)	// O - Length of value string
 {
   int	ch,				// Character from file
 	paren = 0,			// Parenthesis
 	quote = '\0';			// Quote character (if any)
   char	*bufptr = buffer,		// Pointer into string buffer
 	*bufend = buffer + bufsize - 1;	// End of string buffer
+  const char	*data = NULL;		// Scanned data
+  size_t	datalen = bufsize - 1;	// Length of scanned data
 
 
+  *length = 0;
+
   // Skip leading whitespace...
-  while ((ch = hcFileGetc(file)) != EOF)
+  while ((ch = _hcFileGetc(file)) != EOF)
   {
     if (!isspace(ch & 255) || ch == ';' || ch == '}')
       break;
   }
 
-  do
+  if (ch == EOF)
+    return (NULL);
+
+  // Scan a simple value in the file buffer...
+  _hcFileUngetc(file, ch);
+
+  if (hcFileScan(file, "\"'()\\;}", &data, &datalen) && file->bufptr < file->bufend && (*file->bufptr == ';' || *file->bufptr == '}'))
+  {
+    // Remove trailing whitespace...
+    while (datalen > 0 && isspace(data[datalen - 1] & 255))
+      datalen --;
+
+    *length = datalen;
+
+    return (datalen > 0 ? data : NULL);
+  }
+
+  // Otherwise copy what was scanned and read the rest of the value...
+  if (datalen > 0)
+  {
+    memcpy(bufptr, data, datalen);
+    bufptr += datalen;
+  }
+
+  while ((ch = _hcFileGetc(file)) != EOF)
   {
     if (!paren && !quote && (ch == ';' || ch == '}'))
     {
-      hcFileUngetc(file, ch);
+      _hcFileUngetc(file, ch);
       break;
     }
 
@@ -878,7 +936,7 @@ hc_read_value(hc_file_t *file,		// I - File to read from
     }
     else if (ch == '\\')
     {
-      if ((ch = hcFileGetc(file)) != EOF)
+      if ((ch = _hcFileGetc(file)) != EOF)
       {
         if (bufptr < bufend)
           *bufptr++ = (char)ch;
@@ -893,13 +951,13 @@ hc_read_value(hc_file_t *file,		// I - File to read from
       quote = ch;
     }
   }
-  while ((ch = hcFileGetc(file)) != EOF);
 
   // Remove trailing whitespace...
   while (bufptr > buffer && isspace(bufptr[-1] & 255))
     bufptr --;
 
   *bufptr = '\0';
+  *length = (size_t)(bufptr - buffer);
 
-  return (bufptr == buffer ? NULL : buffer);
+  return (*length > 0 ? buffer : NULL);
 }
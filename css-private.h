@@ -96,6 +96,7 @@ typedef struct _hc_rulecol_s		// Collection of rules
 struct _hc_css_s
 {
   hc_pool_t		*pool;		// Memory pool
+  hc_css_t		*next;		// Next stylesheet using the pool
   hc_media_t		media;		// Base media definition
   _hc_rulecol_t		all_rules;	// All rule sets in the stylesheet and document
   _hc_rulecol_t		rules[HC_ELEMENT_MAX];
@@ -109,14 +110,15 @@ struct _hc_css_s
 
 extern void	_hcCSSImportString(hc_css_t *css, hc_dict_t *props, const char *s);
 extern void	_hcCSSSelAddStmt(hc_css_t *css, _hc_css_sel_t *sel, _hc_match_t match, const char *name, const char *value);
-extern void	_hcCSSSelDelete(_hc_css_sel_t *sel);
+extern void	_hcCSSSelDelete(hc_css_t *css, _hc_css_sel_t *sel);
 extern void	_hcCSSSelHash(_hc_css_sel_t *sel, hc_sha3_256_t hash);
 extern _hc_css_sel_t *_hcCSSSelNew(hc_css_t *css, _hc_css_sel_t *prev, hc_element_t element, _hc_relation_t rel);
 
 extern void	_hcRuleColAdd(hc_css_t *css, _hc_rulecol_t *col, _hc_rule_t *rule);
-extern void	_hcRuleColClear(_hc_rulecol_t *col, int delete_rules);
+extern void	_hcRuleColClear(hc_css_t *css, _hc_rulecol_t *col, int delete_rules);
 extern _hc_rule_t *_hcRuleColFindHash(_hc_rulecol_t *col, const hc_sha3_256_t hash);
-extern void	_hcRuleDelete(_hc_rule_t *rule);
+extern void	_hcRuleColPurge(hc_css_t *css, _hc_rulecol_t *col);
+extern void	_hcRuleDelete(hc_css_t *css, _hc_rule_t *rule);
 extern _hc_rule_t *_hcRuleNew(hc_css_t *css, const hc_sha3_256_t hash, _hc_css_sel_t *sel, hc_dict_t *props);
 
 
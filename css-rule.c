@@ -34,7 +34,7 @@ _hcCSSSelAddStmt(hc_css_t      *css,	// I - Stylesheet
   _hc_css_selstmt_t	*temp;		// Current statement
 
 
-  if ((temp = realloc(sel->stmts, (sel->num_stmts + 1) * sizeof(_hc_css_selstmt_t))) != NULL)
+  if ((temp = _hcPoolRealloc(css->pool, sel->stmts, (sel->num_stmts + 1) * sizeof(_hc_css_selstmt_t))) != NULL)
   {
     sel->stmts = temp;
     temp += sel->num_stmts;
@@ -54,7 +54,8 @@ _hcCSSSelAddStmt(hc_css_t      *css,	// I - Stylesheet
 //
 
 void
-_hcCSSSelDelete(_hc_css_sel_t *sel)	// I - Selectors
+_hcCSSSelDelete(hc_css_t      *css,	// I - Stylesheet
+                _hc_css_sel_t *sel)	// I - Selectors
 {
   _hc_css_sel_t *prev;			// Previous selector
 
@@ -63,10 +64,8 @@ _hcCSSSelDelete(_hc_css_sel_t *sel)	// I - Selectors
   {
     prev = sel->prev;
 
-    if (sel->stmts)
-      free(sel->stmts);
-
-    free(sel);
+    _hcPoolFree(css->pool, sel->stmts);
+    _hcPoolFree(css->pool, sel);
 
     sel = prev;
   }
@@ -113,7 +112,7 @@ _hcCSSSelNew(hc_css_t       *css,	// I - Stylesheet
   _hc_css_sel_t	*sel;			// New selector
 
 
-  if ((sel = (_hc_css_sel_t *)calloc(1, sizeof(_hc_css_sel_t))) != NULL)
+  if ((sel = (_hc_css_sel_t *)_hcPoolCalloc(css->pool, 1, sizeof(_hc_css_sel_t))) != NULL)
   {
     sel->prev     = prev;
     sel->element  = element;
@@ -149,7 +148,7 @@ _hcRuleColAdd(hc_css_t      *css,	// I - Stylesheet
     else
       alloc_rules = col->alloc_rules + 32;
 
-    if ((ptr = realloc(col->rules, alloc_rules * sizeof(_hc_rule_t *))) == NULL)
+    if ((ptr = _hcPoolRealloc(css->pool, col->rules, alloc_rules * sizeof(_hc_rule_t *))) == NULL)
     {
       _hcPoolError(css->pool, 0, "Unable to allocate memory for selector rules.");
       return;
@@ -173,6 +172,7 @@ _hcRuleColAdd(hc_css_t      *css,	// I - Stylesheet
 
 void
 _hcRuleColClear(
+    hc_css_t      *css,			// I - Stylesheet
     _hc_rulecol_t *col,			// I - Rule set collection
     int           delete_rules)		// I - 1 to delete rules, 0 to just clear collection
 {
@@ -182,7 +182,7 @@ _hcRuleColClear(
     _hc_rule_t	**ptr;			// Pointer into array
 
     for (i = col->num_rules, ptr = col->rules; i > 0; i --, ptr ++)
-      _hcRuleDelete(*ptr);
+      _hcRuleDelete(css, *ptr);
   }
 
   col->num_rules  = 0;
@@ -190,7 +190,7 @@ _hcRuleColClear(
 
   if (col->alloc_rules > 0)
   {
-    free(col->rules);
+    _hcPoolFree(css->pool, col->rules);
     col->alloc_rules = 0;
     col->rules       = NULL;
   }
@@ -227,16 +227,45 @@ _hcRuleColFindHash(
 }
 
 
+//
+// '_hcRuleColPurge()' - Remove computed rule sets from a collection.
+//
+// Computed rule sets have no selectors and cache the properties for a set of
+// matching rules.
+//
+
+void
+_hcRuleColPurge(hc_css_t      *css,	// I - Stylesheet
+                _hc_rulecol_t *col)	// I - Rule set collection
+{
+  size_t	i,			// Looping var
+		count;			// Number of rules kept
+  _hc_rule_t	**ptr;			// Pointer into array
+
+
+  for (i = col->num_rules, count = 0, ptr = col->rules; i > 0; i --, ptr ++)
+  {
+    if ((*ptr)->sel)
+      col->rules[count ++] = *ptr;
+    else
+      _hcRuleDelete(css, *ptr);
+  }
+
+  col->num_rules = count;
+}
+
+
 //
 // '_hcRuleDelete()' - Free memory used by a rule set.
 //
 
 void
-_hcRuleDelete(_hc_rule_t *rule)		// I - Rule set
+_hcRuleDelete(hc_css_t   *css,		// I - Stylesheet
+              _hc_rule_t *rule)		// I - Rule set
 {
-  _hcCSSSelDelete(rule->sel);
+  _hcCSSSelDelete(css, rule->sel);
   hcDictDelete(rule->props);
-  free(rule);
+  _hcPoolFree(css->pool, rule);
 }
 
 
@@ -254,11 +283,14 @@ _hcRuleNew(
   _hc_rule_t	*rule;			// New rule
 
 
-  if ((rule = calloc(1, sizeof(_hc_rule_t))) != NULL)
+  if ((rule = _hcPoolCalloc(css->pool, 1, sizeof(_hc_rule_t))) != NULL)
   {
     memcpy(rule->hash, hash, sizeof(rule->hash));
     rule->sel   = sel;
     rule->props = hcDictCopy(props);
+
+    // Rule properties don't change, so make lookups as fast as possible...
+    hcDictFreeze(rule->props);
   }
   else
     _hcPoolError(css->pool, 0, "Unable to allocate memory for selector rules.");
@@ -0,0 +1,76 @@
+//
+// Private dictionary header for HTMLCSS library.
+//
+//     https://github.com/michaelrsweet/htmlcss
+//
+// Copyright © 2018-2026 by Michael R Sweet.
+//
+// Licensed under Apache License v2.0.  See the file "LICENSE" for more
+// information.
+//
+
+#ifndef HTMLCSS_DICT_PRIVATE_H
+#  define HTMLCSS_DICT_PRIVATE_H
+#  include "dict.h"
+#  ifdef __cplusplus
+extern "C" {
+#  endif // __cplusplus
+
+
+//
+// Constants...
+//
+
+#  define _HC_DICT_INLINE	4	// Number of pairs stored inline
+
+
+//
+// Types...
+//
+
+typedef struct _hc_pair_s		// Key/value pair
+{
+  const char	*key;			// Key
+  const char	*value;			// Value
+} _hc_pair_t;
+
+typedef struct _hc_dictbuf_s		// Shared pair storage
+{
+  size_t	refcount;		// Number of dictionaries using storage
+  _hc_pair_t	pairs[1];		// Key/value pairs
+} _hc_dictbuf_t;
+
+typedef struct _hc_dicthash_s		// Perfect hash table for frozen dictionaries
+{
+  unsigned	bmask,			// Bucket mask
+		smask;			// Slot mask
+  unsigned	*disp;			// Displacement for each bucket
+  unsigned	*slots;			// Pair index + 1 for each slot, 0 if empty
+} _hc_dicthash_t;
+
+struct _hc_dict_s			// Dictionary
+{
+  hc_pool_t	*pool;			// Memory pool
+  size_t	num_pairs;		// Number of pairs
+  size_t	alloc_pairs;		// Allocated pairs
+  _hc_pair_t	*pairs;			// Key/value pairs
+  _hc_dictbuf_t	*buf;			// Heap storage or `NULL` if inline
+  _hc_dicthash_t *hash;			// Perfect hash table or `NULL` if not frozen
+  _hc_pair_t	inline_pairs[_HC_DICT_INLINE];
+					// Inline storage for small dictionaries
+};
+
+
+//
+// Functions...
+//
+
+extern void	_hcDictClear(hc_dict_t *dict);
+extern void	_hcDictInit(hc_dict_t *dict, hc_pool_t *pool);
+extern void	_hcDictSetPooledKeyValue(hc_dict_t *dict, const char *key, const char *value);
+
+
+#  ifdef __cplusplus
+}
+#  endif // __cplusplus
+#endif // !HTMLCSS_DICT_PRIVATE_H
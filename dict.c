@@ -10,38 +10,59 @@
 //
 
 #include "common-private.h"
-#include "dict.h"
+#include "dict-private.h"
+#include "pool-private.h"
 
 
 //
-// Private types...
+// Local functions...
 //
 
-typedef struct _hc_pair_s		// Key/value pair
-{
-  const char	*key;			// Key
-  const char	*value;			// Value
-} _hc_pair_t;
-
-struct _hc_dict_s			// Dictionary
-{
-  hc_pool_t	*pool;			// Memory pool
-  size_t	num_pairs;		// Number of pairs
-  size_t	alloc_pairs;		// Allocated pairs
-  _hc_pair_t	*pairs;			// Key/value pairs
-};
+static int	compare_pairs(_hc_pair_t *a, _hc_pair_t *b);
+static bool	dict_own(hc_dict_t *dict, size_t alloc_pairs);
+static void	dict_set(hc_dict_t *dict, const char *key, const char *value);
+static unsigned	hash_key(const char *key);
+static unsigned	hash_slot(unsigned hash, unsigned disp);
 
 
 //
-// Local functions...
+// '_hcDictClear()' - Free the pairs of an embedded dictionary.
+//
+// The dictionary structure itself is not freed, allowing it to be reused after
+// calling `_hcDictInit`.
 //
 
-static int	compare_pairs(_hc_pair_t *a, _hc_pair_t *b);
+void
+_hcDictClear(hc_dict_t *dict)		// I - Dictionary
+{
+  if (dict->hash)
+  {
+    _hcPoolFree(dict->pool, dict->hash);
+    dict->hash = NULL;
+  }
+
+  if (dict->buf)
+  {
+    dict->buf->refcount --;
+
+    if (dict->buf->refcount == 0)
+      _hcPoolFree(dict->pool, dict->buf);
+  }
+
+  dict->num_pairs   = 0;
+  dict->alloc_pairs = _HC_DICT_INLINE;
+  dict->pairs       = dict->inline_pairs;
+  dict->buf         = NULL;
+}
 
 
 //
 // 'hcDictCopy()' - Make a copy of a dictionary.
 //
+// The copy shares its key/value storage with the original dictionary until
+// either of them is changed, so copying is cheap regardless of the number of
+// pairs.
+//
 
 hc_dict_t *				// O - New dictionary
 hcDictCopy(const hc_dict_t *dict)	// I - Dictionary to copy
@@ -52,20 +73,27 @@ hcDictCopy(const hc_dict_t *dict)	// I - Dictionary to copy
   if (!dict)
     return (NULL);
 
-  if ((newdict = calloc(1, sizeof(hc_dict_t))) == NULL)
+  if ((newdict = _hcPoolMalloc(dict->pool, sizeof(hc_dict_t))) == NULL)
     return (NULL);
 
-  newdict->pool        = dict->pool;
-  newdict->num_pairs   = dict->num_pairs;
-  newdict->alloc_pairs = dict->num_pairs;
+  _hcDictInit(newdict, dict->pool);
 
-  if ((newdict->pairs = calloc(newdict->num_pairs, sizeof(_hc_pair_t))) == NULL)
+  if (dict->buf)
   {
-    free(newdict);
-    return (NULL);
+    // Share the heap storage...
+    dict->buf->refcount ++;
+
+    newdict->alloc_pairs = dict->alloc_pairs;
+    newdict->pairs       = dict->pairs;
+    newdict->buf         = dict->buf;
+  }
+  else
+  {
+    // Copy the inline pairs...
+    memcpy(newdict->inline_pairs, dict->pairs, dict->num_pairs * sizeof(_hc_pair_t));
   }
 
-  memcpy(newdict->pairs, dict->pairs, newdict->num_pairs * sizeof(_hc_pair_t));
+  newdict->num_pairs = dict->num_pairs;
 
   return (newdict);
 }
@@ -80,11 +108,132 @@ hcDictDelete(hc_dict_t *dict)		// I - Dictionary
 {
   if (dict)
   {
-    if (dict->pairs)
-      free(dict->pairs);
+    _hcDictClear(dict);
+    _hcPoolFree(dict->pool, dict);
+  }
+}
+
+
+//
+// 'hcDictFreeze()' - Build a perfect hash table for a dictionary.
+//
+// Lookups in a frozen dictionary use a single hash table probe instead of a
+// binary search.  Freezing is intended for dictionaries that are no longer
+// changed - changing a frozen dictionary discards the hash table.  Small
+// dictionaries are not hashed since a binary search is just as fast.
+//
+
+bool					// O - `true` on success, `false` on error
+hcDictFreeze(hc_dict_t *dict)		// I - Dictionary
+{
+  size_t		i, j,		// Looping vars
+			num_buckets,	// Number of buckets
+			num_slots,	// Number of slots
+			size;		// Size of bucket
+  unsigned		d,		// Current displacement
+			*hashes = NULL,	// Hashes of keys
+			*order = NULL,	// Keys sorted by bucket
+			*start = NULL,	// Start of each bucket in order
+			*slots = NULL;	// Slots for current bucket
+  _hc_dicthash_t	*hash;		// Hash table
+  bool			ret = false;	// Return value
+
+
+  if (!dict)
+    return (false);
+
+  if (dict->hash || dict->num_pairs <= _HC_DICT_INLINE)
+    return (true);
+
+  // Use about two keys per bucket and keep the load factor at or below 50%...
+  for (num_buckets = 1; num_buckets < dict->num_pairs / 2; num_buckets *= 2);
+  for (num_slots = 1; num_slots < 2 * dict->num_pairs; num_slots *= 2);
+
+  if ((hash = _hcPoolCalloc(dict->pool, 1, sizeof(_hc_dicthash_t) + (num_buckets + num_slots) * sizeof(unsigned))) == NULL)
+    return (false);
+
+  hash->bmask = (unsigned)(num_buckets - 1);
+  hash->smask = (unsigned)(num_slots - 1);
+  hash->disp  = (unsigned *)(hash + 1);
+  hash->slots = hash->disp + num_buckets;
+
+  if ((hashes = _hcPoolMalloc(dict->pool, dict->num_pairs * sizeof(unsigned))) == NULL || (order = _hcPoolMalloc(dict->pool, dict->num_pairs * sizeof(unsigned))) == NULL || (start = _hcPoolCalloc(dict->pool, num_buckets + 1, sizeof(unsigned))) == NULL || (slots = _hcPoolMalloc(dict->pool, dict->num_pairs * sizeof(unsigned))) == NULL)
+    goto done;
+
+  // Group the keys by bucket...
+  for (i = 0; i < dict->num_pairs; i ++)
+  {
+    hashes[i] = hash_key(dict->pairs[i].key);
+    start[(hashes[i] & hash->bmask) + 1] ++;
+  }
+
+  for (i = 0; i < num_buckets; i ++)
+    start[i + 1] += start[i];
+
+  for (i = 0; i < dict->num_pairs; i ++)
+    order[start[hashes[i] & hash->bmask] ++] = (unsigned)i;
+
+  for (i = num_buckets; i > 0; i --)
+    start[i] = start[i - 1];
+  start[0] = 0;
+
+  // Place the largest buckets first, finding a displacement for each bucket
+  // that puts all of its keys in empty slots...
+  for (size = dict->num_pairs; size > 0; size --)
+  {
+    for (i = 0; i < num_buckets; i ++)
+    {
+      if ((start[i + 1] - start[i]) != size)
+        continue;
+
+      for (d = 0; d < 65536; d ++)
+      {
+        for (j = 0; j < size; j ++)
+        {
+          size_t k;			// Looping var
+
+          slots[j] = hash_slot(hashes[order[start[i] + j]], d) & hash->smask;
+
+          if (hash->slots[slots[j]])
+            break;
+
+          for (k = 0; k < j; k ++)
+          {
+            if (slots[k] == slots[j])
+              break;
+          }
+
+          if (k < j)
+            break;
+        }
+
+        if (j == size)
+          break;
+      }
+
+      if (d >= 65536)
+        goto done;
+
+      hash->disp[i] = d;
 
-    free(dict);
+      for (j = 0; j < size; j ++)
+        hash->slots[slots[j]] = order[start[i] + j] + 1;
+    }
   }
+
+  dict->hash = hash;
+  hash       = NULL;
+  ret        = true;
+
+  done:
+
+  _hcPoolFree(dict->pool, hash);
+  _hcPoolFree(dict->pool, hashes);
+  _hcPoolFree(dict->pool, order);
+  _hcPoolFree(dict->pool, start);
+  _hcPoolFree(dict->pool, slots);
+
+  return (ret);
 }
 
 
@@ -131,12 +280,30 @@ hcDictGetKeyValue(
 		*ptr;			// Pointer to match
 
 
-  if (!dict || dict->num_pairs == 0)
+  if (!dict || dict->num_pairs == 0 || !key)
     return (NULL);
 
   temp.key   = key;
   temp.value = NULL;
 
+  if (dict->hash)
+  {
+    // Frozen dictionary, look up the key in the hash table...
+    unsigned	keyhash = hash_key(key),// Hash of key
+		idx = dict->hash->slots[hash_slot(keyhash, dict->hash->disp[keyhash & dict->hash->bmask]) & dict->hash->smask];
+					// Index of pair + 1
+
+    if (!idx)
+      return (NULL);
+
+    ptr = dict->pairs + idx - 1;
+
+    if (ptr->key == key || !compare_pairs(ptr, &temp))
+      return (ptr->value);
+    else
+      return (NULL);
+  }
+
   if ((ptr = (_hc_pair_t *)bsearch(&temp, dict->pairs, dict->num_pairs, sizeof(_hc_pair_t), (_hc_compare_func_t)compare_pairs)) != NULL)
     return (ptr->value);
   else
@@ -144,6 +311,149 @@ hcDictGetKeyValue(
 }
 
 
+//
+// '_hcDictInit()' - Initialize an embedded dictionary.
+//
+
+void
+_hcDictInit(hc_dict_t *dict,		// I - Dictionary
+            hc_pool_t *pool)		// I - Memory pool
+{
+  dict->pool        = pool;
+  dict->num_pairs   = 0;
+  dict->alloc_pairs = _HC_DICT_INLINE;
+  dict->pairs       = dict->inline_pairs;
+  dict->buf         = NULL;
+  dict->hash        = NULL;
+}
+
+
+//
+// 'hcDictMerge()' - Merge the key/value pairs from one dictionary into another.
+//
+// Both dictionaries are already sorted, so the pairs are merged in a single
+// pass.  When a key is present in both dictionaries, the value from the source
+// dictionary is used if `overwrite` is `true`.
+//
+
+bool					// O - `true` on success, `false` on error
+hcDictMerge(hc_dict_t       *dst,	// I - Destination dictionary
+            const hc_dict_t *src,	// I - Source dictionary
+            bool            overwrite)	// I - Replace existing values?
+{
+  size_t	i, j,			// Looping vars
+		count,			// Number of merged pairs
+		alloc_pairs;		// Allocated merged pairs
+  int		result;			// Result of comparison
+  _hc_pair_t	*dptr,			// Pointer into destination pairs
+		*sptr,			// Pointer into source pairs
+		*mptr,			// Pointer into merged pairs
+		temp[_HC_DICT_INLINE];	// Temporary inline pairs
+  _hc_dictbuf_t	*buf = NULL;		// Merged storage
+
+
+  if (!dst || !src)
+    return (false);
+
+  if (src->num_pairs == 0 || dst == src)
+    return (true);
+
+  if (dst->pool != src->pool)
+  {
+    // Strings come from a different pool, so copy them one at a time...
+    for (i = src->num_pairs, sptr = src->pairs; i > 0; i --, sptr ++)
+    {
+      if (overwrite || !hcDictGetKeyValue(dst, sptr->key))
+        hcDictSetKeyValue(dst, sptr->key, sptr->value);
+    }
+
+    return (true);
+  }
+
+  if (dst->num_pairs == 0 && src->buf)
+  {
+    // Just share the source storage...
+    _hcDictClear(dst);
+
+    src->buf->refcount ++;
+
+    dst->num_pairs   = src->num_pairs;
+    dst->alloc_pairs = src->alloc_pairs;
+    dst->pairs       = src->pairs;
+    dst->buf         = src->buf;
+
+    return (true);
+  }
+
+  // Merge the pairs into new storage...
+  alloc_pairs = dst->num_pairs + src->num_pairs;
+
+  if (alloc_pairs <= _HC_DICT_INLINE)
+  {
+    mptr = temp;
+  }
+  else
+  {
+    if ((buf = _hcPoolMalloc(dst->pool, sizeof(_hc_dictbuf_t) + (alloc_pairs - 1) * sizeof(_hc_pair_t))) == NULL)
+      return (false);
+
+    buf->refcount = 1;
+    mptr          = buf->pairs;
+  }
+
+  for (i = dst->num_pairs, j = src->num_pairs, dptr = dst->pairs, sptr = src->pairs, count = 0; i > 0 || j > 0; count ++)
+  {
+    if (i == 0)
+      result = 1;
+    else if (j == 0)
+      result = -1;
+    else if (dptr->key == sptr->key)
+      result = 0;
+    else
+      result = compare_pairs(dptr, sptr);
+
+    if (result < 0)
+    {
+      *mptr++ = *dptr++;
+      i --;
+    }
+    else if (result > 0)
+    {
+      *mptr++ = *sptr++;
+      j --;
+    }
+    else
+    {
+      *mptr++ = overwrite ? *sptr : *dptr;
+      dptr ++;
+      sptr ++;
+      i --;
+      j --;
+    }
+  }
+
+  if (buf)
+  {
+    _hcDictClear(dst);
+
+    dst->alloc_pairs = alloc_pairs;
+    dst->pairs       = buf->pairs;
+    dst->buf         = buf;
+  }
+  else
+  {
+    // Small result, copy back to the inline pairs...
+    _hcDictClear(dst);
+
+    memcpy(dst->inline_pairs, temp, count * sizeof(_hc_pair_t));
+  }
+
+  dst->num_pairs = count;
+
+  return (true);
+}
+
+
 //
 // 'hcDictNew()' - Create a new dictionary.
 //
@@ -154,8 +464,8 @@ hcDictNew(hc_pool_t *pool)		// I - Memory pool
   hc_dict_t	*dict;			// New dictionary
 
 
-  if ((dict = (hc_dict_t *)calloc(1, sizeof(hc_dict_t))) != NULL)
-    dict->pool = pool;
+  if ((dict = (hc_dict_t *)_hcPoolMalloc(pool, sizeof(hc_dict_t))) != NULL)
+    _hcDictInit(dict, pool);
 
   return (dict);
 }
@@ -182,12 +492,15 @@ hcDictRemoveKey(hc_dict_t  *dict,	// I - Dictionary
 
   if ((ptr = (_hc_pair_t *)bsearch(&temp, dict->pairs, dict->num_pairs, sizeof(_hc_pair_t), (_hc_compare_func_t)compare_pairs)) != NULL)
   {
-    dict->num_pairs --;
-
     idx = (size_t)(ptr - dict->pairs);
 
+    if (!dict_own(dict, dict->alloc_pairs))
+      return;
+
+    dict->num_pairs --;
+
     if (idx < dict->num_pairs)
-      memmove(ptr, ptr + 1, (dict->num_pairs - idx) * sizeof(_hc_pair_t));
+      memmove(dict->pairs + idx, dict->pairs + idx + 1, (dict->num_pairs - idx) * sizeof(_hc_pair_t));
   }
 }
 
@@ -201,71 +514,238 @@ hcDictSetKeyValue(hc_dict_t  *dict,	// I - Dictionary
 	          const char *key,	// I - Key string
 	          const char *value)	// I - Value string
 {
-  _hc_pair_t	temp,			// Search key
-		*ptr = NULL;		// New key/value pair
+  _HC_DEBUG("hcDictSetKeyValue(dict=%p, key=\"%s\", value=\"%s\")\n", (void *)dict, key, value);
 
+  if (!dict || !key)
+    return;
 
-  _HC_DEBUG("hcDictSetKeyValue(dict=%p, key=\"%s\", value=\"%s\")\n", (void *)dict, key, value);
+  dict_set(dict, hcPoolGetString(dict->pool, key), hcPoolGetString(dict->pool, value));
+}
 
-  if (!dict)
-  {
+
+//
+// 'hcDictSetKeyValueLen()' - Set a key/value pair in a dictionary using strings
+//                            of the specified lengths.
+//
+// The key and value strings need not be nul-terminated, allowing them to be
+// copied directly from a larger buffer.
+//
+
+void
+hcDictSetKeyValueLen(
+    hc_dict_t  *dict,			// I - Dictionary
+    const char *key,			// I - Key string
+    size_t     keylen,			// I - Length of key string
+    const char *value,			// I - Value string
+    size_t     valuelen)		// I - Length of value string
+{
+  if (!dict || !key)
     return;
+
+  dict_set(dict, hcPoolGetStringLen(dict->pool, key, keylen), hcPoolGetStringLen(dict->pool, value, valuelen));
+}
+
+
+//
+// '_hcDictSetPooledKeyValue()' - Set a key/value pair using pooled strings.
+//
+// The key and value strings must already be in the dictionary's memory pool,
+// which avoids looking them up again.
+//
+
+void
+_hcDictSetPooledKeyValue(
+    hc_dict_t  *dict,			// I - Dictionary
+    const char *key,			// I - Pooled key string
+    const char *value)			// I - Pooled value string
+{
+  if (!dict || !key)
+    return;
+
+  dict_set(dict, key, value);
+}
+
+
+//
+// 'compare_pairs()' - Compare two key/value pairs.
+//
+
+static int				// O - Result of comparison
+compare_pairs(_hc_pair_t *a,		// I - First pair
+              _hc_pair_t *b)		// I - Second pair
+{
+#ifdef _WIN32
+  return (_stricmp(a->key, b->key));
+#else
+  return (strcasecmp(a->key, b->key));
+#endif // _WIN32
+}
+
+
+//
+// 'dict_own()' - Make sure a dictionary has its own storage for the specified
+//                number of pairs.
+//
+// Storage that is shared with copies of the dictionary is copied before it is
+// changed.
+//
+
+static bool				// O - `true` on success, `false` on error
+dict_own(hc_dict_t *dict,		// I - Dictionary
+         size_t    alloc_pairs)		// I - Number of pairs needed
+{
+  _hc_dictbuf_t	*buf;			// New storage
+  size_t	bufsize;		// Size of storage
+
+
+  if (dict->hash)
+  {
+    // Changing a frozen dictionary discards the hash table...
+    _hcPoolFree(dict->pool, dict->hash);
+    dict->hash = NULL;
   }
-  else if (dict->num_pairs == 1 && !strcmp(dict->pairs[0].key, key))
+
+  if (alloc_pairs <= dict->alloc_pairs && (!dict->buf || dict->buf->refcount == 1))
+    return (true);
+
+  if (alloc_pairs < dict->alloc_pairs)
+    alloc_pairs = dict->alloc_pairs;
+
+  bufsize = sizeof(_hc_dictbuf_t) + (alloc_pairs - 1) * sizeof(_hc_pair_t);
+
+  if (dict->buf && dict->buf->refcount == 1)
   {
-    ptr = dict->pairs;
+    // Grow our own storage...
+    if ((buf = _hcPoolRealloc(dict->pool, dict->buf, bufsize)) == NULL)
+      return (false);
   }
-  else if (dict->num_pairs > 1)
+  else
   {
-    temp.key = key;
+    // Copy inline or shared pairs to new storage...
+    if ((buf = _hcPoolMalloc(dict->pool, bufsize)) == NULL)
+      return (false);
 
-    ptr = (_hc_pair_t *)bsearch(&temp, dict->pairs, dict->num_pairs, sizeof(_hc_pair_t), (_hc_compare_func_t)compare_pairs);
+    buf->refcount = 1;
+    memcpy(buf->pairs, dict->pairs, dict->num_pairs * sizeof(_hc_pair_t));
+
+    if (dict->buf)
+      dict->buf->refcount --;
   }
 
-  if (ptr)
-  {
-    ptr->value = hcPoolGetString(dict->pool, value);
+  dict->alloc_pairs = alloc_pairs;
+  dict->pairs       = buf->pairs;
+  dict->buf         = buf;
+
+  return (true);
+}
+
+
+//
+// 'dict_set()' - Set a pooled key/value pair in a dictionary.
+//
+// New pairs are inserted in sorted order using a binary search, so the pairs
+// array never needs to be re-sorted.
+//
+
+static void
+dict_set(hc_dict_t  *dict,		// I - Dictionary
+         const char *key,		// I - Pooled key string
+         const char *value)		// I - Pooled value string
+{
+  size_t	left,			// Left side of search
+		right,			// Right side of search
+		current;		// Current pair
+  int		result;			// Result of comparison
+  _hc_pair_t	*ptr;			// New key/value pair
+
+
+  if (!key)
     return;
-  }
 
-  if (dict->num_pairs >= dict->alloc_pairs)
+  // Find the pair or the insertion point for it...
+  for (left = 0, right = dict->num_pairs; left < right;)
   {
-    if ((ptr = realloc(dict->pairs, (dict->alloc_pairs + 4) * sizeof(_hc_pair_t))) == NULL)
-      return;
+    current = (left + right) / 2;
+
+    if (dict->pairs[current].key == key)
+      result = 0;
+    else
+#ifdef _WIN32
+      result = _stricmp(key, dict->pairs[current].key);
+#else
+      result = strcasecmp(key, dict->pairs[current].key);
+#endif // _WIN32
 
-    dict->alloc_pairs += 4;
-    dict->pairs       = ptr;
+    if (result == 0)
+    {
+      if (dict->pairs[current].value != value && dict_own(dict, dict->alloc_pairs))
+        dict->pairs[current].value = value;
+      return;
+    }
+    else if (result < 0)
+      right = current;
+    else
+      left = current + 1;
   }
 
-  ptr = dict->pairs + dict->num_pairs;
-  dict->num_pairs ++;
+  // Not found, make room for the new pair...
+  if (!dict_own(dict, dict->num_pairs < dict->alloc_pairs ? dict->alloc_pairs : 2 * dict->alloc_pairs))
+    return;
 
-  ptr->key   = hcPoolGetString(dict->pool, key);
-  ptr->value = hcPoolGetString(dict->pool, value);
+  ptr = dict->pairs + left;
 
-  qsort(dict->pairs, dict->num_pairs, sizeof(_hc_pair_t), (_hc_compare_func_t)compare_pairs);
+  if (left < dict->num_pairs)
+    memmove(ptr + 1, ptr, (dict->num_pairs - left) * sizeof(_hc_pair_t));
+
+  dict->num_pairs ++;
+
+  ptr->key   = key;
+  ptr->value = value;
 
 #ifdef DEBUG
   size_t i;
 
-  _HC_DEBUG("hxDictSetKeyValue: num_pairs=%d\n", (int)dict->num_pairs);
+  _HC_DEBUG("dict_set: num_pairs=%d\n", (int)dict->num_pairs);
   for (i = 0, ptr = dict->pairs; i < dict->num_pairs; i ++, ptr ++)
-    _HC_DEBUG("hcDictSetKeyValue: pairs[%d].key=\"%s\", .value=\"%s\"\n", (int)i, ptr->key, ptr->value);
+    _HC_DEBUG("dict_set: pairs[%d].key=\"%s\", .value=\"%s\"\n", (int)i, ptr->key, ptr->value);
 #endif // DEBUG
 }
 
 
 //
-// 'compare_pairs()' - Compare two key/value pairs.
+// 'hash_key()' - Compute the case-insensitive hash of a key.
 //
 
-static int				// O - Result of comparison
-compare_pairs(_hc_pair_t *a,		// I - First pair
-              _hc_pair_t *b)		// I - Second pair
+static unsigned				// O - Hash value
+hash_key(const char *key)		// I - Key string
 {
-#ifdef _WIN32
-  return (_stricmp(a->key, b->key));
-#else
-  return (strcasecmp(a->key, b->key));
-#endif // _WIN32
+  unsigned	hash = 2166136261u;	// Hash value
+
+
+  // FNV-1a hash of the lowercase key...
+  while (*key)
+  {
+    hash ^= (unsigned)tolower(*key & 255);
+    hash *= 16777619u;
+    key ++;
+  }
+
+  return (hash);
+}
+
+
+//
+// 'hash_slot()' - Compute the slot hash for a key using a displacement.
+//
+
+static unsigned				// O - Slot hash value
+hash_slot(unsigned hash,		// I - Hash of key
+          unsigned disp)		// I - Displacement for bucket
+{
+  hash ^= disp * 0x9e3779b9u;
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6bu;
+  hash ^= hash >> 13;
+
+  return (hash);
 }
@@ -31,12 +31,15 @@ typedef struct _hc_dict_s hc_dict_t;
 
 extern hc_dict_t	*hcDictCopy(const hc_dict_t *dict);
 extern void		hcDictDelete(hc_dict_t *dict);
+extern bool		hcDictFreeze(hc_dict_t *dict);
 extern size_t		hcDictGetCount(const hc_dict_t *dict);
 extern const char	*hcDictGetIndexKeyValue(const hc_dict_t *dict, size_t idx, const char **key);
 extern const char	*hcDictGetKeyValue(const hc_dict_t *dict, const char *key);
+extern bool		hcDictMerge(hc_dict_t *dst, const hc_dict_t *src, bool overwrite);
 extern hc_dict_t	*hcDictNew(hc_pool_t *pool);
 extern void		hcDictRemoveKey(hc_dict_t *dict, const char *key);
 extern void		hcDictSetKeyValue(hc_dict_t *dict, const char *key, const char *value);
+extern void		hcDictSetKeyValueLen(hc_dict_t *dict, const char *key, size_t keylen, const char *value, size_t valuelen);
 
 
 #  ifdef __cplusplus
@@ -3,7 +3,7 @@
 //
 //     https://github.com/michaelrsweet/htmlcss
 //
-// Copyright © 2018-2025 by Michael R Sweet.
+// Copyright © 2018-2026 by Michael R Sweet.
 //
 // Licensed under Apache License v2.0.  See the file "LICENSE" for more
 // information.
@@ -14,11 +14,31 @@
 #  include "file.h"
 #  include "pool-private.h"
 #  include <zlib.h>
+#  ifndef _WIN32
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#  endif // !_WIN32
 #  ifdef __cplusplus
 extern "C" {
 #  endif // __cplusplus
 
 
+//
+// Constants...
+//
+
+#  define _HC_FILE_BUFSIZE	16384	// Size of read-ahead buffer for compressed files
+
+
+//
+// Macros...
+//
+
+#  define _hcFileGetc(f)	((f)->bufptr < (f)->bufend ? (int)*((f)->bufptr)++ : _hcFileFill(f))
+#  define _hcFileUngetc(f,ch)	do { if ((ch) != EOF && (f)->bufptr > (f)->buffer) (f)->bufptr --; } while (0)
+
+
 //
 // Types...
 //
@@ -28,10 +48,13 @@ struct _hc_file_s			// High-level file/stream
   hc_pool_t		*pool;		// Memory pool
   const char		*url;		// URL or filename
   gzFile		fp;		// File pointer
+  _hc_uchar_t		*readbuf;	// Read-ahead buffer for compressed files
   const _hc_uchar_t	*buffer,	// String buffer
 			*bufptr,	// Pointer into buffer
-			*bufend;	// End of buffer
-  int			linenum;	// Current line number
+			*bufend,	// End of buffer
+			*lineptr;	// Position in buffer of current line number
+  bool			mapped;		// Is the buffer memory-mapped?
+  int			linenum;	// Line number at `lineptr`
 };
 
 
@@ -40,6 +63,8 @@ struct _hc_file_s			// High-level file/stream
 //
 
 extern bool	_hcFileError(hc_file_t *file, const char *message, ...) _HC_FORMAT_ARGS(2,3);
+extern int	_hcFileFill(hc_file_t *file);
+extern int	_hcFileGetLine(hc_file_t *file);
 
 
 #  ifdef __cplusplus
@@ -3,13 +3,23 @@
 //
 //     https://github.com/michaelrsweet/htmlcss
 //
-// Copyright © 2018-2025 by Michael R Sweet.
+// Copyright © 2018-2026 by Michael R Sweet.
 //
 // Licensed under Apache License v2.0.  See the file "LICENSE" for more
 // information.
 //
 
 #include "file-private.h"
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif // __SSE2__
+
+
+//
+// Local functions...
+//
+
+static const _hc_uchar_t *scan_bytes(const _hc_uchar_t *ptr, const _hc_uchar_t *end, const char *delims);
 
 
 //
@@ -25,7 +35,14 @@ hcFileDelete(hc_file_t *file)		// I - File
   if (file->fp)
     gzclose(file->fp);
 
-  free(file);
+  _hcPoolFree(file->pool, file->readbuf);
+
+#ifndef _WIN32
+  if (file->mapped)
+    munmap((void *)file->buffer, (size_t)(file->bufend - file->buffer));
+#endif // !_WIN32
+
+  _hcPoolFree(file->pool, file);
 }
 
 
@@ -43,6 +60,8 @@ _hcFileError(hc_file_t  *file,		// I - File
 		*saniptr,		// Pointer into sanitized URL
 		temp[1024];		// Temporary message buffer
   const char	*urlptr;		// Pointer into URL
+  int		linenum = _hcFileGetLine(file);
+					// Current line number
   va_list	ap;			// Pointer to arguments
 
 
@@ -59,21 +78,21 @@ _hcFileError(hc_file_t  *file,		// I - File
     *saniptr = '\0';
 
     // Create a new message format string with the correct prefix...
-    if (file->linenum)
-      snprintf(temp, sizeof(temp), "%s:%d: %s", saniurl, file->linenum, message);
+    if (linenum)
+      snprintf(temp, sizeof(temp), "%s:%d: %s", saniurl, linenum, message);
     else if (file->url)
       snprintf(temp, sizeof(temp), "%s: %s", saniurl, message);
     message = temp;
   }
-  else if (file->linenum)
+  else if (linenum)
   {
     // Create a new message format string with a line number prefix...
-    snprintf(temp, sizeof(temp), "%d: %s", file->linenum, message);
+    snprintf(temp, sizeof(temp), "%d: %s", linenum, message);
     message = temp;
   }
 
   va_start(ap, message);
-  ret = _hcPoolErrorv(file->pool, file->linenum, message, ap);
+  ret = _hcPoolErrorv(file->pool, linenum, message, ap);
   va_end(ap);
 
   return (ret);
@@ -81,29 +100,93 @@ _hcFileError(hc_file_t  *file,		// I - File
 
 
 //
-// 'hcFileGetc()' - Get a character from a file.
+// '_hcFileFill()' - Fill the read-ahead buffer and return the next character.
+//
+// This is called by the `_hcFileGetc` macro when the buffer is empty.  The last
+// character of the previous buffer is kept so that it can be returned to the
+// file with `_hcFileUngetc`.
 //
 
 int					// O - Character or `EOF`
-hcFileGetc(hc_file_t *file)		// I - File
+_hcFileFill(hc_file_t *file)		// I - File
 {
-  int	ch;				// Current character
+  int	bytes;				// Bytes read
+
+
+  if (!file->fp || !file->readbuf)
+    return (EOF);
 
+  // Count the lines in the current buffer before replacing it...
+  _hcFileGetLine(file);
 
-  if (file->bufptr)
+  if (file->bufend > file->buffer)
   {
-    if (file->bufptr < file->bufend)
-      ch = (int)*(file->bufptr)++;
-    else
-      ch = EOF;
+    file->readbuf[0] = file->bufend[-1];
+    file->buffer     = file->readbuf;
   }
   else
-    ch = gzgetc(file->fp);
+  {
+    file->buffer = file->readbuf + 1;
+  }
+
+  file->bufptr  = file->readbuf + 1;
+  file->bufend  = file->bufptr;
+  file->lineptr = file->bufptr;
+
+  if ((bytes = gzread(file->fp, file->readbuf + 1, _HC_FILE_BUFSIZE)) <= 0)
+    return (EOF);
 
-  if (ch == '\n')
-    file->linenum ++;
+  file->bufend += bytes;
 
-  return (ch);
+  return ((int)*(file->bufptr)++);
+}
+
+
+//
+// '_hcFileGetLine()' - Get the current line number in a file.
+//
+// Only the buffer position is tracked as characters are read.  Newlines are
+// counted from the last known position when a line number is needed, for
+// example when reporting an error, or before a compressed file's read-ahead
+// buffer is replaced.  A line number of `0` means the line is not known.
+//
+
+int					// O - Line number
+_hcFileGetLine(hc_file_t *file)		// I - File
+{
+  const _hc_uchar_t	*ptr;		// Pointer into buffer
+
+
+  if (!file->lineptr || !file->linenum)
+    return (file->linenum);
+
+  if (file->lineptr < file->bufptr)
+  {
+    // Count newlines that have been read...
+    for (ptr = file->lineptr; (ptr = memchr(ptr, '\n', (size_t)(file->bufptr - ptr))) != NULL; ptr ++)
+      file->linenum ++;
+  }
+  else
+  {
+    // Uncount newlines that were returned to the file...
+    for (ptr = file->bufptr; (ptr = memchr(ptr, '\n', (size_t)(file->lineptr - ptr))) != NULL; ptr ++)
+      file->linenum --;
+  }
+
+  file->lineptr = file->bufptr;
+
+  return (file->linenum);
+}
+
+
+//
+// 'hcFileGetc()' - Get a character from a file.
+//
+
+int					// O - Character or `EOF`
+hcFileGetc(hc_file_t *file)		// I - File
+{
+  return (_hcFileGetc(file));
 }
 
 
@@ -119,12 +202,13 @@ hcFileNewBuffer(hc_pool_t  *pool,	// I - Memory pool
   hc_file_t	*file;			// File
 
 
-  if ((file = calloc(1, sizeof(hc_file_t))) != NULL)
+  if ((file = _hcPoolCalloc(pool, 1, sizeof(hc_file_t))) != NULL)
   {
     file->pool    = pool;
     file->buffer  = buffer;
     file->bufptr  = file->buffer;
     file->bufend  = file->buffer + bytes;
+    file->lineptr = file->buffer;
     file->linenum = 1;
   }
 
@@ -147,6 +231,10 @@ hcFileNewString(hc_pool_t  *pool,	// I - Memory pool
 //
 // 'hcFileNewURL()' - Create a new file URL stream.
 //
+// Uncompressed local files are memory-mapped when possible and read directly
+// from memory.  Files starting with the gzip magic number are decompressed as
+// they are read.
+//
 
 hc_file_t *				// O - File
 hcFileNewURL(hc_pool_t  *pool,		// I - Memory pool
@@ -155,6 +243,11 @@ hcFileNewURL(hc_pool_t  *pool,		// I - Memory pool
 {
   hc_file_t	*file;			// File
   const char	*filename;		// Local file
+#ifndef _WIN32
+  int		fd;			// File descriptor
+  struct stat	fileinfo;		// File information
+  void		*data;			// Mapped file data
+#endif // !_WIN32
 
 
   _HC_DEBUG("hcFileNewURL(pool=%p, url=\"%s\", baseurl=\"%s\")\n", (void *)pool, url, baseurl);
@@ -164,21 +257,90 @@ hcFileNewURL(hc_pool_t  *pool,		// I - Memory pool
 
   _HC_DEBUG("hcFileNewURL: filename=\"%s\"\n", filename);
 
-  if ((file = calloc(1, sizeof(hc_file_t))) != NULL)
+  if ((file = _hcPoolCalloc(pool, 1, sizeof(hc_file_t))) == NULL)
+    return (NULL);
+
+  file->pool    = pool;
+  file->url     = filename;
+  file->linenum = 1;
+
+#ifdef _WIN32
+  file->fp = gzopen(filename, "rb");
+
+#else
+  if ((fd = open(filename, O_RDONLY)) < 0)
   {
-    file->pool    = pool;
-    file->url     = filename;
-    file->fp      = gzopen(filename, "rb");
-    file->linenum = 1;
+    perror(filename);
+    _hcPoolFree(pool, file);
+    return (NULL);
+  }
 
-    if (!file->fp)
+  if (!fstat(fd, &fileinfo) && S_ISREG(fileinfo.st_mode))
+  {
+    if (fileinfo.st_size == 0)
     {
-      perror(filename);
-      free(file);
-      file = NULL;
+      // Empty file...
+      close(fd);
+
+      file->buffer  = (const _hc_uchar_t *)"";
+      file->bufptr  = file->buffer;
+      file->bufend  = file->buffer;
+      file->lineptr = file->buffer;
+
+      return (file);
+    }
+    else if ((data = mmap(NULL, (size_t)fileinfo.st_size, PROT_READ, MAP_PRIVATE, fd, 0)) != MAP_FAILED)
+    {
+      const _hc_uchar_t *bytes = (const _hc_uchar_t *)data;
+					// Bytes in file
+
+      if (fileinfo.st_size >= 2 && bytes[0] == 0x1f && bytes[1] == 0x8b)
+      {
+        // Compressed, read using zlib...
+        munmap(data, (size_t)fileinfo.st_size);
+      }
+      else
+      {
+        // Uncompressed, read directly from memory...
+        close(fd);
+
+        madvise(data, (size_t)fileinfo.st_size, MADV_SEQUENTIAL);
+
+        file->buffer  = bytes;
+        file->bufptr  = file->buffer;
+        file->bufend  = file->buffer + fileinfo.st_size;
+        file->lineptr = file->buffer;
+        file->mapped  = true;
+
+        return (file);
+      }
     }
   }
 
+  if ((file->fp = gzdopen(fd, "rb")) == NULL)
+    close(fd);
+#endif // _WIN32
+
+  if (!file->fp)
+  {
+    perror(filename);
+    _hcPoolFree(pool, file);
+    return (NULL);
+  }
+
+  // Read compressed files using a read-ahead buffer, with an extra byte at the
+  // start for returning a character to the file...
+  if ((file->readbuf = _hcPoolMalloc(pool, _HC_FILE_BUFSIZE + 1)) == NULL)
+  {
+    hcFileDelete(file);
+    return (NULL);
+  }
+
+  file->buffer  = file->readbuf + 1;
+  file->bufptr  = file->buffer;
+  file->bufend  = file->buffer;
+  file->lineptr = file->buffer;
+
   return (file);
 }
 
@@ -192,14 +354,18 @@ hcFileRead(hc_file_t *file,		// I - File
            void      *buffer,		// I - Buffer
            size_t    bytes)		// I - Number of bytes to read
 {
+  size_t	count;			// Number of buffered bytes
   ssize_t	rbytes;			// Number of bytes read
+  const _hc_uchar_t	*ptr,		// Pointer into bytes read
+			*end;		// End of bytes read
 
 
   if (!file || !buffer || bytes == 0)
     return (0);
 
-  if (file->bufptr)
+  if (!file->fp || (size_t)(file->bufend - file->bufptr) >= bytes)
   {
+    // Copy from the buffer...
     if ((size_t)(file->bufend - file->bufptr) < bytes)
       bytes = (size_t)(file->bufend - file->bufptr);
 
@@ -211,10 +377,91 @@ hcFileRead(hc_file_t *file,		// I - File
 
     return (bytes);
   }
-  else if ((rbytes = gzread(file->fp, buffer, (unsigned)bytes)) < 0)
-    return (0);
+
+  // Copy any buffered bytes and then read the rest from the file...
+  if ((count = (size_t)(file->bufend - file->bufptr)) > 0)
+  {
+    memcpy(buffer, file->bufptr, count);
+    file->bufptr += count;
+  }
+
+  if ((rbytes = gzread(file->fp, (char *)buffer + count, (unsigned)(bytes - count))) <= 0)
+    return (count);
+
+  // Count the lines that were read and then keep the last byte in the
+  // read-ahead buffer so it can be returned with `_hcFileUngetc`...
+  _hcFileGetLine(file);
+
+  ptr = (const _hc_uchar_t *)buffer + count;
+  end = ptr + rbytes;
+
+  if (file->linenum)
+  {
+    for (; (ptr = memchr(ptr, '\n', (size_t)(end - ptr))) != NULL; ptr ++)
+      file->linenum ++;
+  }
+
+  if (file->readbuf)
+  {
+    file->readbuf[0] = end[-1];
+    file->buffer     = file->readbuf;
+    file->bufptr     = file->readbuf + 1;
+    file->bufend     = file->bufptr;
+    file->lineptr    = file->bufptr;
+  }
+
+  return (count + (size_t)rbytes);
+}
+
+
+//
+// 'hcFileScan()' - Scan for the next delimiter in a file.
+//
+// This function returns a pointer to the bytes up to (but not including) the
+// next delimiter character or end of buffer, and advances the file past them.
+// The returned bytes are not nul-terminated and remain valid until the next
+// read from the file.  A length of `0` means that the next character is a
+// delimiter.
+//
+// On input, `datalen` holds the maximum number of bytes to return.
+//
+
+bool					// O  - `true` on success, `false` on end-of-file
+hcFileScan(hc_file_t  *file,		// I  - File
+           const char *delims,		// I  - Delimiter characters
+           const char **data,		// O  - Bytes before delimiter
+           size_t     *datalen)		// IO - Maximum length on input, number of bytes on output
+{
+  size_t		maxlen;		// Maximum length
+  const _hc_uchar_t	*end;		// End of scan
+
+
+  if (!file || !delims || !data || !datalen)
+    return (false);
+
+  maxlen   = *datalen;
+  *data    = NULL;
+  *datalen = 0;
+
+  if (file->bufptr >= file->bufend)
+  {
+    // Refill the buffer and put back the first character...
+    if (_hcFileFill(file) == EOF)
+      return (false);
+
+    file->bufptr --;
+  }
+
+  if ((size_t)(file->bufend - file->bufptr) < maxlen)
+    end = file->bufend;
   else
-    return ((size_t)rbytes);
+    end = file->bufptr + maxlen;
+
+  *data        = (const char *)file->bufptr;
+  file->bufptr = scan_bytes(file->bufptr, end, delims);
+  *datalen     = (size_t)(file->bufptr - (const _hc_uchar_t *)*data);
+
+  return (true);
 }
 
 
@@ -232,7 +479,7 @@ hcFileSeek(hc_file_t *file,		// I - File
   if (!file)
     return (0);
 
-  if (file->bufptr)
+  if (!file->fp)
   {
     if (offset > (size_t)(file->bufend - file->buffer))
       offset = (size_t)(file->bufend - file->buffer);
@@ -242,10 +489,20 @@ hcFileSeek(hc_file_t *file,		// I - File
     return (offset);
   }
 
+  // Discard the read-ahead buffer and seek in the compressed file...
+  file->buffer  = file->readbuf + 1;
+  file->bufptr  = file->buffer;
+  file->bufend  = file->buffer;
+  file->lineptr = file->buffer;
+
   if ((soffset = gzseek(file->fp, (long)offset, SEEK_SET)) < 0)
     return (0);
-  else
-    return ((size_t)soffset);
+
+  // Newlines before the new offset have not been read, so the line number is
+  // only known at the start of the file...
+  file->linenum = soffset == 0 ? 1 : 0;
+
+  return ((size_t)soffset);
 }
 
 
@@ -254,14 +511,57 @@ hcFileSeek(hc_file_t *file,		// I - File
 //
 
 void
-hcFileUngetc(hc_file_t *f,		// I - File
+hcFileUngetc(hc_file_t *file,		// I - File
              int       ch)		// I - Character
 {
-  if (f->bufptr && f->bufptr > f->buffer)
-    f->bufptr --;
-  else if (f->fp)
-    gzungetc(ch, f->fp);
+  _hcFileUngetc(file, ch);
+}
+
+
+//
+// 'scan_bytes()' - Find the first delimiter in a range of bytes.
+//
+
+static const _hc_uchar_t *		// O - First delimiter or `end` if none
+scan_bytes(const _hc_uchar_t *ptr,	// I - Start of bytes
+           const _hc_uchar_t *end,	// I - End of bytes
+           const char        *delims)	// I - Delimiter characters
+{
+#if defined(__SSE2__) && defined(__GNUC__)
+  size_t	i,			// Looping var
+		num_delims = strlen(delims);
+					// Number of delimiters
+  __m128i	dvecs[4],		// Delimiter vectors
+		block,			// Block of bytes
+		match;			// Matching bytes
+  int		mask;			// Mask of matching bytes
+
+
+  // Compare 16 bytes at a time against up to 4 delimiters...
+  if (num_delims > 0 && num_delims <= 4)
+  {
+    for (i = 0; i < num_delims; i ++)
+      dvecs[i] = _mm_set1_epi8(delims[i]);
+
+    while ((end - ptr) >= 16)
+    {
+      block = _mm_loadu_si128((const __m128i *)ptr);
+      match = _mm_cmpeq_epi8(block, dvecs[0]);
+
+      for (i = 1; i < num_delims; i ++)
+        match = _mm_or_si128(match, _mm_cmpeq_epi8(block, dvecs[i]));
+
+      if ((mask = _mm_movemask_epi8(match)) != 0)
+        return (ptr + __builtin_ctz((unsigned)mask));
+
+      ptr += 16;
+    }
+  }
+#endif // __SSE2__ && __GNUC__
+
+  // Check the remaining bytes one at a time...
+  while (ptr < end && (!*ptr || !strchr(delims, *ptr)))
+    ptr ++;
 
-  if (ch == '\n')
-    f->linenum --;
+  return (ptr);
 }
@@ -34,6 +34,7 @@ extern hc_file_t	*hcFileNewBuffer(hc_pool_t *pool, const void *buffer, size_t by
 extern hc_file_t	*hcFileNewString(hc_pool_t *pool, const char *s);
 extern hc_file_t	*hcFileNewURL(hc_pool_t *pool, const char *url, const char *baseurl);
 extern size_t		hcFileRead(hc_file_t *file, void *buffer, size_t bytes);
+extern bool		hcFileScan(hc_file_t *file, const char *delims, const char **data, size_t *datalen);
 extern size_t		hcFileSeek(hc_file_t *file, size_t offset);
 extern void		hcFileUngetc(hc_file_t *file, int ch);
 
@@ -22,7 +22,7 @@ hcNodeAttrGetCount(hc_node_t *node)	// I - Element node
   if (!node || node->element < HC_ELEMENT_DOCTYPE)
     return (0);
   else
-    return (hcDictGetCount(node->value.element.attrs));
+    return (hcDictGetCount(&node->value.element.attrs));
 }
 
 
@@ -39,7 +39,7 @@ hcNodeAttrGetIndexNameValue(
   if (!node || node->element < HC_ELEMENT_DOCTYPE || !name)
     return (NULL);
 
-  return (hcDictGetIndexKeyValue(node->value.element.attrs, idx, name));
+  return (hcDictGetIndexKeyValue(&node->value.element.attrs, idx, name));
 }
 
 
@@ -55,7 +55,7 @@ hcNodeAttrGetNameValue(
   if (!node || node->element < HC_ELEMENT_DOCTYPE || !name)
     return (NULL);
 
-  return (hcDictGetKeyValue(node->value.element.attrs, name));
+  return (hcDictGetKeyValue(&node->value.element.attrs, name));
 }
 
 
@@ -70,7 +70,7 @@ hcNodeAttrRemove(hc_node_t  *node,	// I - Element node
   if (!node || node->element < HC_ELEMENT_DOCTYPE || !name)
     return;
 
-  hcDictRemoveKey(node->value.element.attrs, name);
+  hcDictRemoveKey(&node->value.element.attrs, name);
 }
 
 
@@ -87,8 +87,25 @@ hcNodeAttrSetNameValue(
   if (!node || node->element < HC_ELEMENT_DOCTYPE || !name || !value)
     return;
 
-  if (!node->value.element.attrs)
-    node->value.element.attrs = hcDictNew(node->value.element.html->pool);
+  hcDictSetKeyValue(&node->value.element.attrs, name, value);
+}
+
+
+//
+// 'hcNodeAttrSetNameValueLen()' - Add an element attribute using strings of the
+//                                 specified lengths.
+//
+
+void
+hcNodeAttrSetNameValueLen(
+    hc_node_t  *node,			// I - Element node
+    const char *name,			// I - Attribute name
+    size_t     namelen,			// I - Length of attribute name
+    const char *value,			// I - Attribute value
+    size_t     valuelen)		// I - Length of attribute value
+{
+  if (!node || node->element < HC_ELEMENT_DOCTYPE || !name || !value)
+    return;
 
-  hcDictSetKeyValue(node->value.element.attrs, name, value);
+  hcDictSetKeyValueLen(&node->value.element.attrs, name, namelen, value, valuelen);
 }
@@ -0,0 +1,80 @@
+//
+// HTML attribute hash table for HTMLCSS library, generated by makeelements.
+//
+//     https://github.com/michaelrsweet/htmlcss
+//
+// Copyright © 2025 by Michael R Sweet.
+//
+// Licensed under Apache License v2.0.  See the file "LICENSE" for more
+// information.
+//
+
+#define HC_ATTR_BUCKETS	7
+#define HC_ATTR_SLOTS	48
+
+static const unsigned short attr_disp[HC_ATTR_BUCKETS] =
+{
+  11,
+  0,
+  0,
+  4,
+  2,
+  0,
+  0
+};
+
+static const struct
+{
+  signed char	attr;			// Index in html_attrs or -1
+  unsigned char	length;			// Length of name
+} attr_slots[HC_ATTR_SLOTS] =
+{
+  { 1, 10 },
+  { 19, 4 },
+  { 22, 6 },
+  { -1, 0 },
+  { 17, 3 },
+  { 20, 4 },
+  { 12, 4 },
+  { 0, 5 },
+  { 10, 4 },
+  { -1, 0 },
+  { -1, 0 },
+  { -1, 0 },
+  { 3, 6 },
+  { 7, 5 },
+  { 2, 7 },
+  { 21, 6 },
+  { -1, 0 },
+  { 9, 3 },
+  { -1, 0 },
+  { 8, 5 },
+  { -1, 0 },
+  { -1, 0 },
+  { 23, 5 },
+  { -1, 0 },
+  { -1, 0 },
+  { -1, 0 },
+  { -1, 0 },
+  { -1, 0 },
+  { 15, 7 },
+  { -1, 0 },
+  { 13, 6 },
+  { -1, 0 },
+  { -1, 0 },
+  { 18, 5 },
+  { -1, 0 },
+  { -1, 0 },
+  { -1, 0 },
+  { 5, 11 },
+  { -1, 0 },
+  { -1, 0 },
+  { 6, 5 },
+  { 11, 6 },
+  { -1, 0 },
+  { 14, 2 },
+  { -1, 0 },
+  { 16, 6 },
+  { -1, 0 },
+  { 4, 11 }
+};
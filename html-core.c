@@ -10,6 +10,7 @@
 //
 
 #include "html-private.h"
+#include "html-elements.h"
 #include <stdarg.h>
 
 
@@ -154,13 +155,6 @@ static const char * const elements[HC_ELEMENT_MAX] =
 };
 
 
-//
-// Local functions...
-//
-
-static int	compare_elements(const char **a, const char **b);
-
-
 //
 // 'hcElementString()' - Return the string associated with an element enum value.
 //
@@ -184,18 +178,53 @@ hcElementString(hc_element_t e)		// I - HTML element enum
 hc_element_t				// O - HTML element enum
 hcElementValue(const char *s)		// I - HTML element string
 {
-  const char	**match;		// Match from bsearch
+  const char	*sptr,			// Pointer into string
+		*eptr;			// Pointer into element name
+  int		sch,			// Current string character (lowercase)
+		ech;			// Current element character (lowercase)
+  unsigned	bhash = 0,		// Bucket hash
+		shash = 0;		// Slot hash
+  size_t	slot;			// Slot in hash table
+  hc_element_t	e;			// Element
 
 
   // Range check input...
   if (!s || !*s)
     return (HC_ELEMENT_UNKNOWN);
 
-  // Search for the string...
-  if ((match = (const char **)bsearch(&s, elements, sizeof(elements) / sizeof(elements[0]), sizeof(elements[0]), (int (*)(const void *, const void *))compare_elements)) != NULL)
-    return ((hc_element_t)(match - elements));
-  else
+  // Hash the lowercase string (see makeelements)...
+  for (sptr = s; *sptr; sptr ++)
+  {
+    sch = *sptr & 255;
+    if (sch >= 'A' && sch <= 'Z')
+      sch += 'a' - 'A';
+
+    bhash = (bhash * 33 + (unsigned)sch) & 0xffffff;
+    shash = (shash * 31 + (unsigned)sch) & 0xffffff;
+  }
+
+  // Look up the slot and compare the length before the name...
+  slot = (shash + element_disp[bhash % HC_ELEMENT_BUCKETS]) % HC_ELEMENT_SLOTS;
+  e    = element_slots[slot].element;
+
+  if (e == HC_ELEMENT_UNKNOWN || element_slots[slot].length != (size_t)(sptr - s))
     return (HC_ELEMENT_UNKNOWN);
+
+  for (sptr = s, eptr = elements[e]; *sptr; sptr ++, eptr ++)
+  {
+    sch = *sptr & 255;
+    ech = *eptr;
+
+    if (sch >= 'A' && sch <= 'Z')
+      sch += 'a' - 'A';
+    if (ech >= 'A' && ech <= 'Z')
+      ech += 'a' - 'A';
+
+    if (sch != ech)
+      return (HC_ELEMENT_UNKNOWN);
+  }
+
+  return (e);
 }
 
 
@@ -209,7 +238,7 @@ hcHTMLDelete(hc_html_t *html)		// I - HTML document
   if (html)
   {
     hcNodeDelete(html, html->root);
-    free(html);
+    _hcPoolFree(html->pool, html);
   }
 }
 
@@ -236,7 +265,7 @@ hcHTMLNew(hc_pool_t *pool,		// I - Memory pool
   hc_html_t *html;			// New HTML document
 
 
-  if ((html = (hc_html_t *)calloc(1, sizeof(hc_html_t))) != NULL)
+  if ((html = (hc_html_t *)_hcPoolCalloc(pool, 1, sizeof(hc_html_t))) != NULL)
   {
     html->pool     = pool;
     html->css      = css;
@@ -249,16 +278,18 @@ hcHTMLNew(hc_pool_t *pool,		// I - Memory pool
 
 
 //
-// 'compare_elements()' - Compare two elements...
+// 'hcHTMLSetSplitText()' - Set whether text is split into a node per line.
+//
+// By default, `hcHTMLImport` and the push parser add each run of text between
+// elements as a single string node.  Pass `true` to instead start a new string
+// node after each newline.
 //
 
-static int				// O - Result of comparison
-compare_elements(const char **a,	// I - First string
-		 const char **b)	// I - Second string
+void
+hcHTMLSetSplitText(hc_html_t *html,	// I - HTML document
+                   bool      split)	// I - `true` to split text at newlines
 {
-#ifdef WIN32
-  return (_stricmp(*a, *b));
-#else
-  return (strcasecmp(*a, *b));
-#endif // WIN32
+  if (html)
+    html->split_text = split;
 }
+
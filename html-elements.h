@@ -0,0 +1,325 @@
+//
+// HTML element hash table for HTMLCSS library, generated by makeelements.
+//
+//     https://github.com/michaelrsweet/htmlcss
+//
+// Copyright © 2025 by Michael R Sweet.
+//
+// Licensed under Apache License v2.0.  See the file "LICENSE" for more
+// information.
+//
+
+#define HC_ELEMENT_BUCKETS	33
+#define HC_ELEMENT_SLOTS	267
+
+static const unsigned short element_disp[HC_ELEMENT_BUCKETS] =
+{
+  5,
+  2,
+  0,
+  0,
+  0,
+  2,
+  1,
+  0,
+  0,
+  0,
+  1,
+  6,
+  2,
+  0,
+  2,
+  1,
+  3,
+  0,
+  2,
+  5,
+  1,
+  2,
+  12,
+  0,
+  0,
+  0,
+  1,
+  0,
+  17,
+  19,
+  1,
+  0,
+  3
+};
+
+static const struct
+{
+  hc_element_t	element;		// Element
+  unsigned char	length;			// Length of name
+} element_slots[HC_ELEMENT_SLOTS] =
+{
+  { HC_ELEMENT_MAP, 3 },
+  { HC_ELEMENT_TITLE, 5 },
+  { HC_ELEMENT_BUTTON, 6 },
+  { HC_ELEMENT_DOCTYPE, 8 },
+  { HC_ELEMENT_DL, 2 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_DT, 2 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_DEL, 3 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_SMALL, 5 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_SOURCE, 6 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_APPLET, 6 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_TBODY, 5 },
+  { HC_ELEMENT_WBR, 3 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_INS, 3 },
+  { HC_ELEMENT_EM, 2 },
+  { HC_ELEMENT_SPAN, 4 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_BODY, 4 },
+  { HC_ELEMENT_HEAD, 4 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_THEAD, 5 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_DETAILS, 7 },
+  { HC_ELEMENT_RTC, 3 },
+  { HC_ELEMENT_COMMENT, 3 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_DIALOG, 6 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_MULTICOL, 8 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_DFN, 3 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_META, 4 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_STRONG, 6 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_PROGRESS, 8 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_H2, 2 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_H1, 2 },
+  { HC_ELEMENT_H3, 2 },
+  { HC_ELEMENT_H5, 2 },
+  { HC_ELEMENT_STRIKE, 6 },
+  { HC_ELEMENT_H6, 2 },
+  { HC_ELEMENT_H4, 2 },
+  { HC_ELEMENT_OL, 2 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_BIG, 3 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_AUDIO, 5 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_TEMPLATE, 8 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_ACRONYM, 7 },
+  { HC_ELEMENT_AREA, 4 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_A, 1 },
+  { HC_ELEMENT_SELECT, 6 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_B, 1 },
+  { HC_ELEMENT_BASE, 4 },
+  { HC_ELEMENT_LINK, 4 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_I, 1 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_VAR, 3 },
+  { HC_ELEMENT_VIDEO, 5 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_P, 1 },
+  { HC_ELEMENT_FRAMESET, 8 },
+  { HC_ELEMENT_PARAM, 5 },
+  { HC_ELEMENT_Q, 1 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_PICTURE, 7 },
+  { HC_ELEMENT_S, 1 },
+  { HC_ELEMENT_U, 1 },
+  { HC_ELEMENT_OPTION, 6 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_ARTICLE, 7 },
+  { HC_ELEMENT_STYLE, 5 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_SUMMARY, 7 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_BLOCKQUOTE, 10 },
+  { HC_ELEMENT_ABBR, 4 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_HR, 2 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_EMBED, 5 },
+  { HC_ELEMENT_OBJECT, 6 },
+  { HC_ELEMENT_SAMP, 4 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_DIR, 3 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_FONT, 4 },
+  { HC_ELEMENT_HTML, 4 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_DIV, 3 },
+  { HC_ELEMENT_CENTER, 6 },
+  { HC_ELEMENT_ASIDE, 5 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_TABLE, 5 },
+  { HC_ELEMENT_CODE, 4 },
+  { HC_ELEMENT_MENU, 4 },
+  { HC_ELEMENT_RB, 2 },
+  { HC_ELEMENT_COL, 3 },
+  { HC_ELEMENT_MAIN, 4 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_BLINK, 5 },
+  { HC_ELEMENT_MARK, 4 },
+  { HC_ELEMENT_DATA, 4 },
+  { HC_ELEMENT_NAV, 3 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_RP, 2 },
+  { HC_ELEMENT_FRAME, 5 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_RT, 2 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_OUTPUT, 6 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_TFOOT, 5 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_FIELDSET, 8 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_SPACER, 6 },
+  { HC_ELEMENT_OPTGROUP, 8 },
+  { HC_ELEMENT_FOOTER, 6 },
+  { HC_ELEMENT_PRE, 3 },
+  { HC_ELEMENT_BDI, 3 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_RUBY, 4 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_BDO, 3 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_METER, 5 },
+  { HC_ELEMENT_NOBR, 4 },
+  { HC_ELEMENT_NOSCRIPT, 8 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_HEADER, 6 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_TRACK, 5 },
+  { HC_ELEMENT_TEXTAREA, 8 },
+  { HC_ELEMENT_CANVAS, 6 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_BR, 2 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_BASEFONT, 8 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_LABEL, 5 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_TD, 2 },
+  { HC_ELEMENT_FIGCAPTION, 10 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_TIME, 4 },
+  { HC_ELEMENT_TH, 2 },
+  { HC_ELEMENT_CITE, 4 },
+  { HC_ELEMENT_LEGEND, 6 },
+  { HC_ELEMENT_SUB, 3 },
+  { HC_ELEMENT_KBD, 3 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_FIGURE, 6 },
+  { HC_ELEMENT_IFRAME, 6 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_TR, 2 },
+  { HC_ELEMENT_TT, 2 },
+  { HC_ELEMENT_NOFRAMES, 8 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_SUP, 3 },
+  { HC_ELEMENT_INPUT, 5 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_CAPTION, 7 },
+  { HC_ELEMENT_LI, 2 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_COLGROUP, 8 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_ADDRESS, 7 },
+  { HC_ELEMENT_IMG, 3 },
+  { HC_ELEMENT_DATALIST, 8 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_SCRIPT, 6 },
+  { HC_ELEMENT_SECTION, 7 },
+  { HC_ELEMENT_ISINDEX, 7 },
+  { HC_ELEMENT_UNKNOWN, 0 },
+  { HC_ELEMENT_UL, 2 },
+  { HC_ELEMENT_DD, 2 },
+  { HC_ELEMENT_FORM, 4 }
+};
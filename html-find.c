@@ -75,11 +75,11 @@ html_walk_next(hc_node_t *current)	// I - Current node
     {
       do
       {
-        next = hcNodeGetParentNode(current);
+        current = hcNodeGetParentNode(current);
       }
-      while (next && hcNodeGetNextSiblingNode(next) == NULL);
+      while (current && hcNodeGetNextSiblingNode(current) == NULL);
 
-      next = hcNodeGetNextSiblingNode(next);
+      next = hcNodeGetNextSiblingNode(current);
     }
   }
 
@@ -10,6 +10,7 @@
 //
 
 #include "html-private.h"
+#include "html-attrs.h"
 #include "file-private.h"
 #include <ctype.h>
 
@@ -27,561 +28,1837 @@
 #define html_istentry(x)	((x) == HC_ELEMENT_TD || (x) == HC_ELEMENT_TH)
 
 
+//
+// Local types...
+//
+
+typedef enum _hc_html_scan_e		// HTML push parser scanning state
+{
+  _HC_HTML_SCAN_TEXT,			// Text
+  _HC_HTML_SCAN_LT,			// Text after '<'
+  _HC_HTML_SCAN_NAME,			// Element name
+  _HC_HTML_SCAN_DOCTYPE_SPACE,		// Whitespace before DOCTYPE value
+  _HC_HTML_SCAN_DOCTYPE,		// DOCTYPE value
+  _HC_HTML_SCAN_DOCTYPE_QUOTE,		// Quoted DOCTYPE value
+  _HC_HTML_SCAN_UNKNOWN,		// Unknown element or directive
+  _HC_HTML_SCAN_UNKNOWN_QUOTE,		// Quoted string in unknown markup
+  _HC_HTML_SCAN_COMMENT,		// Comment
+  _HC_HTML_SCAN_ATTR_SPACE,		// Whitespace before attribute
+  _HC_HTML_SCAN_ATTR_NAME,		// Attribute name
+  _HC_HTML_SCAN_ATTR_VALUE,		// Start of attribute value
+  _HC_HTML_SCAN_ATTR_QUOTE,		// Quoted attribute value
+  _HC_HTML_SCAN_ATTR_UNQUOTED		// Unquoted attribute value
+} _hc_html_scan_t;
+
+struct _hc_html_parser_s		// HTML push parser
+{
+  hc_html_t	*html;			// HTML document
+  hc_node_t	*parent;		// Current parent node
+  hc_file_t	file;			// File for complete data
+  char		*data;			// Pending data
+  size_t	datalen,		// Length of pending data
+		dataalloc;		// Allocated size of pending data
+  bool		status,			// Parse status
+		stop;			// Stop parsing?
+  size_t	scanpos;		// Offset of unscanned data
+  _hc_html_scan_t scanstate;		// Scanning state
+  int		scanquote,		// Quote character
+		scandashes;		// Number of dashes in comment
+  bool		scanclose;		// Scanning a close element?
+  size_t	scannamelen;		// Length of element name
+  char		scanname[256];		// Element name
+};
+
+
+//
+// Local globals...
+//
+
+static const char * const html_attrs[_HC_HTML_ATTRS] =
+{					// Known attribute names (see makeelements)
+  "align",
+  "background",
+  "bgcolor",
+  "border",
+  "cellpadding",
+  "cellspacing",
+  "class",
+  "clear",
+  "color",
+  "dir",
+  "face",
+  "height",
+  "href",
+  "hspace",
+  "id",
+  "noshade",
+  "nowrap",
+  "src",
+  "style",
+  "text",
+  "type",
+  "valign",
+  "vspace",
+  "width"
+};
+
+static const unsigned short html_cp1252[32] =
+{					// Windows-1252 characters for &#128; to &#159;
+  0x20ac, 0x0000, 0x201a, 0x0192, 0x201e, 0x2026, 0x2020, 0x2021,
+  0x02c6, 0x2030, 0x0160, 0x2039, 0x0152, 0x0000, 0x017d, 0x0000,
+  0x0000, 0x2018, 0x2019, 0x201c, 0x201d, 0x2022, 0x2013, 0x2014,
+  0x02dc, 0x2122, 0x0161, 0x203a, 0x0153, 0x0000, 0x017e, 0x0178
+};
+
+static const struct
+{
+  const char	*name;			// Reference name
+  const char	*text;			// UTF-8 text
+} html_refs[] =
+{					// Named character references (sorted)
+  { "AElig",    "\xc3\x86" },
+  { "Aacute",   "\xc3\x81" },
+  { "Acirc",    "\xc3\x82" },
+  { "Agrave",   "\xc3\x80" },
+  { "Alpha",    "\xce\x91" },
+  { "Aring",    "\xc3\x85" },
+  { "Atilde",   "\xc3\x83" },
+  { "Auml",     "\xc3\x84" },
+  { "Beta",     "\xce\x92" },
+  { "Ccedil",   "\xc3\x87" },
+  { "Chi",      "\xce\xa7" },
+  { "Dagger",   "\xe2\x80\xa1" },
+  { "Delta",    "\xce\x94" },
+  { "ETH",      "\xc3\x90" },
+  { "Eacute",   "\xc3\x89" },
+  { "Ecirc",    "\xc3\x8a" },
+  { "Egrave",   "\xc3\x88" },
+  { "Epsilon",  "\xce\x95" },
+  { "Eta",      "\xce\x97" },
+  { "Euml",     "\xc3\x8b" },
+  { "Gamma",    "\xce\x93" },
+  { "Iacute",   "\xc3\x8d" },
+  { "Icirc",    "\xc3\x8e" },
+  { "Igrave",   "\xc3\x8c" },
+  { "Iota",     "\xce\x99" },
+  { "Iuml",     "\xc3\x8f" },
+  { "Kappa",    "\xce\x9a" },
+  { "Lambda",   "\xce\x9b" },
+  { "Mu",       "\xce\x9c" },
+  { "Ntilde",   "\xc3\x91" },
+  { "Nu",       "\xce\x9d" },
+  { "OElig",    "\xc5\x92" },
+  { "Oacute",   "\xc3\x93" },
+  { "Ocirc",    "\xc3\x94" },
+  { "Ograve",   "\xc3\x92" },
+  { "Omega",    "\xce\xa9" },
+  { "Omicron",  "\xce\x9f" },
+  { "Oslash",   "\xc3\x98" },
+  { "Otilde",   "\xc3\x95" },
+  { "Ouml",     "\xc3\x96" },
+  { "Phi",      "\xce\xa6" },
+  { "Pi",       "\xce\xa0" },
+  { "Prime",    "\xe2\x80\xb3" },
+  { "Psi",      "\xce\xa8" },
+  { "Rho",      "\xce\xa1" },
+  { "Scaron",   "\xc5\xa0" },
+  { "Sigma",    "\xce\xa3" },
+  { "THORN",    "\xc3\x9e" },
+  { "Tau",      "\xce\xa4" },
+  { "Theta",    "\xce\x98" },
+  { "Uacute",   "\xc3\x9a" },
+  { "Ucirc",    "\xc3\x9b" },
+  { "Ugrave",   "\xc3\x99" },
+  { "Upsilon",  "\xce\xa5" },
+  { "Uuml",     "\xc3\x9c" },
+  { "Xi",       "\xce\x9e" },
+  { "Yacute",   "\xc3\x9d" },
+  { "Yuml",     "\xc5\xb8" },
+  { "Zeta",     "\xce\x96" },
+  { "aacute",   "\xc3\xa1" },
+  { "acirc",    "\xc3\xa2" },
+  { "acute",    "\xc2\xb4" },
+  { "aelig",    "\xc3\xa6" },
+  { "agrave",   "\xc3\xa0" },
+  { "alefsym",  "\xe2\x84\xb5" },
+  { "alpha",    "\xce\xb1" },
+  { "amp",      "&" },
+  { "and",      "\xe2\x88\xa7" },
+  { "ang",      "\xe2\x88\xa0" },
+  { "apos",     "'" },
+  { "aring",    "\xc3\xa5" },
+  { "asymp",    "\xe2\x89\x88" },
+  { "atilde",   "\xc3\xa3" },
+  { "auml",     "\xc3\xa4" },
+  { "bdquo",    "\xe2\x80\x9e" },
+  { "beta",     "\xce\xb2" },
+  { "brvbar",   "\xc2\xa6" },
+  { "bull",     "\xe2\x80\xa2" },
+  { "cap",      "\xe2\x88\xa9" },
+  { "ccedil",   "\xc3\xa7" },
+  { "cedil",    "\xc2\xb8" },
+  { "cent",     "\xc2\xa2" },
+  { "chi",      "\xcf\x87" },
+  { "circ",     "\xcb\x86" },
+  { "clubs",    "\xe2\x99\xa3" },
+  { "cong",     "\xe2\x89\x85" },
+  { "copy",     "\xc2\xa9" },
+  { "crarr",    "\xe2\x86\xb5" },
+  { "cup",      "\xe2\x88\xaa" },
+  { "curren",   "\xc2\xa4" },
+  { "dArr",     "\xe2\x87\x93" },
+  { "dagger",   "\xe2\x80\xa0" },
+  { "darr",     "\xe2\x86\x93" },
+  { "deg",      "\xc2\xb0" },
+  { "delta",    "\xce\xb4" },
+  { "diams",    "\xe2\x99\xa6" },
+  { "divide",   "\xc3\xb7" },
+  { "eacute",   "\xc3\xa9" },
+  { "ecirc",    "\xc3\xaa" },
+  { "egrave",   "\xc3\xa8" },
+  { "empty",    "\xe2\x88\x85" },
+  { "emsp",     "\xe2\x80\x83" },
+  { "ensp",     "\xe2\x80\x82" },
+  { "epsilon",  "\xce\xb5" },
+  { "equiv",    "\xe2\x89\xa1" },
+  { "eta",      "\xce\xb7" },
+  { "eth",      "\xc3\xb0" },
+  { "euml",     "\xc3\xab" },
+  { "euro",     "\xe2\x82\xac" },
+  { "exist",    "\xe2\x88\x83" },
+  { "fnof",     "\xc6\x92" },
+  { "forall",   "\xe2\x88\x80" },
+  { "frac12",   "\xc2\xbd" },
+  { "frac14",   "\xc2\xbc" },
+  { "frac34",   "\xc2\xbe" },
+  { "frasl",    "\xe2\x81\x84" },
+  { "gamma",    "\xce\xb3" },
+  { "ge",       "\xe2\x89\xa5" },
+  { "gt",       ">" },
+  { "hArr",     "\xe2\x87\x94" },
+  { "harr",     "\xe2\x86\x94" },
+  { "hearts",   "\xe2\x99\xa5" },
+  { "hellip",   "\xe2\x80\xa6" },
+  { "iacute",   "\xc3\xad" },
+  { "icirc",    "\xc3\xae" },
+  { "iexcl",    "\xc2\xa1" },
+  { "igrave",   "\xc3\xac" },
+  { "image",    "\xe2\x84\x91" },
+  { "infin",    "\xe2\x88\x9e" },
+  { "int",      "\xe2\x88\xab" },
+  { "iota",     "\xce\xb9" },
+  { "iquest",   "\xc2\xbf" },
+  { "isin",     "\xe2\x88\x88" },
+  { "iuml",     "\xc3\xaf" },
+  { "kappa",    "\xce\xba" },
+  { "lArr",     "\xe2\x87\x90" },
+  { "lambda",   "\xce\xbb" },
+  { "lang",     "\xe2\x8c\xa9" },
+  { "laquo",    "\xc2\xab" },
+  { "larr",     "\xe2\x86\x90" },
+  { "lceil",    "\xe2\x8c\x88" },
+  { "ldquo",    "\xe2\x80\x9c" },
+  { "le",       "\xe2\x89\xa4" },
+  { "lfloor",   "\xe2\x8c\x8a" },
+  { "lowast",   "\xe2\x88\x97" },
+  { "loz",      "\xe2\x97\x8a" },
+  { "lrm",      "\xe2\x80\x8e" },
+  { "lsaquo",   "\xe2\x80\xb9" },
+  { "lsquo",    "\xe2\x80\x98" },
+  { "lt",       "<" },
+  { "macr",     "\xc2\xaf" },
+  { "mdash",    "\xe2\x80\x94" },
+  { "micro",    "\xc2\xb5" },
+  { "middot",   "\xc2\xb7" },
+  { "minus",    "\xe2\x88\x92" },
+  { "mu",       "\xce\xbc" },
+  { "nabla",    "\xe2\x88\x87" },
+  { "nbsp",     "\xc2\xa0" },
+  { "ndash",    "\xe2\x80\x93" },
+  { "ne",       "\xe2\x89\xa0" },
+  { "ni",       "\xe2\x88\x8b" },
+  { "not",      "\xc2\xac" },
+  { "notin",    "\xe2\x88\x89" },
+  { "nsub",     "\xe2\x8a\x84" },
+  { "ntilde",   "\xc3\xb1" },
+  { "nu",       "\xce\xbd" },
+  { "oacute",   "\xc3\xb3" },
+  { "ocirc",    "\xc3\xb4" },
+  { "oelig",    "\xc5\x93" },
+  { "ograve",   "\xc3\xb2" },
+  { "oline",    "\xe2\x80\xbe" },
+  { "omega",    "\xcf\x89" },
+  { "omicron",  "\xce\xbf" },
+  { "oplus",    "\xe2\x8a\x95" },
+  { "or",       "\xe2\x88\xa8" },
+  { "ordf",     "\xc2\xaa" },
+  { "ordm",     "\xc2\xba" },
+  { "oslash",   "\xc3\xb8" },
+  { "otilde",   "\xc3\xb5" },
+  { "otimes",   "\xe2\x8a\x97" },
+  { "ouml",     "\xc3\xb6" },
+  { "para",     "\xc2\xb6" },
+  { "part",     "\xe2\x88\x82" },
+  { "permil",   "\xe2\x80\xb0" },
+  { "perp",     "\xe2\x8a\xa5" },
+  { "phi",      "\xcf\x86" },
+  { "pi",       "\xcf\x80" },
+  { "piv",      "\xcf\x96" },
+  { "plusmn",   "\xc2\xb1" },
+  { "pound",    "\xc2\xa3" },
+  { "prime",    "\xe2\x80\xb2" },
+  { "prod",     "\xe2\x88\x8f" },
+  { "prop",     "\xe2\x88\x9d" },
+  { "psi",      "\xcf\x88" },
+  { "quot",     "\"" },
+  { "rArr",     "\xe2\x87\x92" },
+  { "radic",    "\xe2\x88\x9a" },
+  { "rang",     "\xe2\x8c\xaa" },
+  { "raquo",    "\xc2\xbb" },
+  { "rarr",     "\xe2\x86\x92" },
+  { "rceil",    "\xe2\x8c\x89" },
+  { "rdquo",    "\xe2\x80\x9d" },
+  { "real",     "\xe2\x84\x9c" },
+  { "reg",      "\xc2\xae" },
+  { "rfloor",   "\xe2\x8c\x8b" },
+  { "rho",      "\xcf\x81" },
+  { "rlm",      "\xe2\x80\x8f" },
+  { "rsaquo",   "\xe2\x80\xba" },
+  { "rsquo",    "\xe2\x80\x99" },
+  { "sbquo",    "\xe2\x80\x9a" },
+  { "scaron",   "\xc5\xa1" },
+  { "sdot",     "\xe2\x8b\x85" },
+  { "sect",     "\xc2\xa7" },
+  { "shy",      "\xc2\xad" },
+  { "sigma",    "\xcf\x83" },
+  { "sigmaf",   "\xcf\x82" },
+  { "sim",      "\xe2\x88\xbc" },
+  { "spades",   "\xe2\x99\xa0" },
+  { "sub",      "\xe2\x8a\x82" },
+  { "sube",     "\xe2\x8a\x86" },
+  { "sum",      "\xe2\x88\x91" },
+  { "sup",      "\xe2\x8a\x83" },
+  { "sup1",     "\xc2\xb9" },
+  { "sup2",     "\xc2\xb2" },
+  { "sup3",     "\xc2\xb3" },
+  { "supe",     "\xe2\x8a\x87" },
+  { "szlig",    "\xc3\x9f" },
+  { "tau",      "\xcf\x84" },
+  { "there4",   "\xe2\x88\xb4" },
+  { "theta",    "\xce\xb8" },
+  { "thetasym", "\xcf\x91" },
+  { "thinsp",   "\xe2\x80\x89" },
+  { "thorn",    "\xc3\xbe" },
+  { "tilde",    "\xcb\x9c" },
+  { "times",    "\xc3\x97" },
+  { "trade",    "\xe2\x84\xa2" },
+  { "uArr",     "\xe2\x87\x91" },
+  { "uacute",   "\xc3\xba" },
+  { "uarr",     "\xe2\x86\x91" },
+  { "ucirc",    "\xc3\xbb" },
+  { "ugrave",   "\xc3\xb9" },
+  { "uml",      "\xc2\xa8" },
+  { "upsih",    "\xcf\x92" },
+  { "upsilon",  "\xcf\x85" },
+  { "uuml",     "\xc3\xbc" },
+  { "weierp",   "\xe2\x84\x98" },
+  { "xi",       "\xce\xbe" },
+  { "yacute",   "\xc3\xbd" },
+  { "yen",      "\xc2\xa5" },
+  { "yuml",     "\xc3\xbf" },
+  { "zeta",     "\xce\xb6" },
+  { "zwj",      "\xe2\x80\x8d" },
+  { "zwnj",     "\xe2\x80\x8c" }
+};
+
+
 //
 // Local functions...
 //
 
-static int	html_parse_attr(hc_file_t *file, int ch, hc_node_t *node);
-static bool	html_parse_comment(hc_file_t *file, hc_node_t **parent);
+static bool	html_add_attr(hc_html_t *html, const char *name, size_t namelen, const char *value, size_t valuelen);
+static bool	html_close_nodes(hc_html_t *html, hc_node_t **parent, hc_node_t *node);
+static bool	html_grow_text(hc_html_t *html, char **buffer, char **bufptr, char **bufend);
+static bool	html_new_comment(hc_html_t *html, hc_node_t *parent, const char *c, size_t clen);
+static hc_node_t *html_new_element(hc_html_t *html, hc_node_t *parent, hc_element_t element);
+static hc_node_t *html_new_root(hc_html_t *html, const char *doctype);
+static bool	html_new_string(hc_html_t *html, hc_node_t *parent, const char *s, size_t slen);
+static int	html_parse_attr(hc_file_t *file, int ch, hc_html_t *html, hc_node_t *node);
+static bool	html_parse_comment(hc_file_t *file, hc_html_t *html, hc_node_t **parent);
 static bool	html_parse_doctype(hc_file_t *file, hc_html_t *html, hc_node_t **parent);
 static bool	html_parse_element(hc_file_t *file, int ch, hc_html_t *html, hc_node_t **parent);
-static bool	html_parse_unknown(hc_file_t *file, hc_node_t **parent, const char *unk);
+static bool	html_parse_file(hc_file_t *file, hc_html_t *html, hc_node_t **parent, bool *stop);
+static void	html_parse_pending(hc_html_parser_t *parser, size_t length);
+static size_t	html_parse_ref(hc_file_t *file, bool attr, char *buffer);
+static bool	html_parse_unknown(hc_file_t *file, hc_html_t *html, hc_node_t **parent, const char *unk);
+static size_t	html_scan_data(hc_html_parser_t *parser);
+static bool	html_scan_markup(hc_html_parser_t *parser, const _hc_uchar_t **dataptr, const _hc_uchar_t *end, bool rooted);
+static bool	html_start_element(hc_html_t *html, hc_node_t *node);
 
 
 //
 // 'hcHTMLImport()' - Load a HTML file into a document.
 //
+// Character references such as "&amp;" and "&#x2014;" in text and attribute
+// values are decoded to UTF-8.
+//
 
 bool					// O - `true` on success, `false` on error
 hcHTMLImport(hc_html_t *html,		// I - HTML document
 	     hc_file_t *file)		// I - File to import
 {
   hc_node_t	*parent = NULL;		// Parent node
-  bool		status = true;		// Load status
-  int		ch;			// Current character
-  char		buffer[8192],		// Temporary buffer
-		*bufptr,		// Pointer into buffer
-		*bufend;		// End of buffer
+  bool		stop = false;		// Stop parsing?
 
 
   // Range check input...
   if (!html || html->root || !file)
     return (false);
 
-//  f.parent       = NULL;
-
   // Parse file...
-  bufptr = buffer;
-  bufend = buffer + sizeof(buffer) - 1;
+  return (html_parse_file(file, html, &parent, &stop));
+}
 
-  while ((ch = hcFileGetc(file)) != EOF)
-  {
-    if (ch == '<')
-    {
-      // Read a HTML element...
-      ch = hcFileGetc(file);
 
-      if (isspace(ch) || ch == '=' || ch == '<')
-      {
-        // Sigh...  "<" followed by anything but an element name is invalid
-        // HTML, but many pages are still broken.  Log it and abort if the error
-        // callback says to...
-        if (!_hcFileError(file, "Unquoted '<'."))
-        {
-          status = false;
-          break;
-        }
+//
+// 'hcHTMLParse()' - Parse a HTML file and report events to callbacks.
+//
+// This function parses a HTML file like `hcHTMLImport` without building a
+// document tree.  The start callback is called for each element (including
+// the root "!DOCTYPE" element) once its attributes are parsed, and the end
+// callback is called when the element is closed, either explicitly or
+// implicitly.  The text and comment callbacks are called for text runs and
+// comments.  Unknown elements and directives are skipped.
+//
+// The strings passed to the callbacks are nul-terminated and are only valid
+// until the callback returns.  Attribute names and values are copied to a
+// buffer that is reused for each element rather than added to the memory pool,
+// so unlike the attribute names in a document tree they must be compared with
+// `strcmp` and not by pointer.  Callbacks return `true` to continue parsing or
+// `false` to stop.  When a callback stops parsing no further callbacks are
+// made, but when parsing stops because of an error the end callback is still
+// called for each open element.
+//
 
-        if (bufptr >= (bufend - 1))
-        {
-	  // Add text string...
-	  if (parent)
-	  {
-	    *bufptr = '\0';
-	    hcNodeNewString(parent, buffer);
-	    bufptr = buffer;
-	  }
-	  else
-	  {
-	    status = false;
-	    _hcFileError(file, "Text without leading element or directive.");
-	    break;
-	  }
-        }
+bool					// O - `true` on success, `false` on error or stop
+hcHTMLParse(
+    hc_file_t              *file,	// I - File to parse
+    const hc_html_events_t *events,	// I - Event callbacks
+    void                   *ctx)	// I - Callback context pointer
+{
+  hc_html_t	html;			// Parsing state
+  hc_node_t	*parent = NULL,		// Parent node
+		*node;			// Current node
+  bool		status,			// Parse status
+		stop = false;		// Stop parsing?
 
-        *bufptr++ = '<';
 
-	if (ch == '<')
-	  hcFileUngetc(file, ch);
-        else
-          *bufptr++ = (char)ch;
-      }
-      else
-      {
-        // Got the first character of an element name, add any pending text and
-        // then parse the element...
-	if (bufptr > buffer)
-	{
-	  // Add text string...
-	  if (parent)
-	  {
-	    *bufptr = '\0';
-	    hcNodeNewString(parent, buffer);
-	    bufptr = buffer;
-	  }
-	  else
-	  {
-	    status = false;
-	    _hcFileError(file, "Text without leading element or directive.");
-	    break;
-	  }
-	}
+  // Range check input...
+  if (!file || !events)
+    return (false);
 
-	if (!(status = html_parse_element(file, ch, html, &parent)))
-	  break;
-      }
-    }
-    else
-    {
-      if (bufptr < bufend)
-        *bufptr++ = (char)ch;
+  // Parse file...
+  memset(&html, 0, sizeof(html));
 
-      if (ch == '\n' || bufptr >= bufend)
-      {
-	if (parent)
-	{
-	  *bufptr = '\0';
-	  hcNodeNewString(parent, buffer);
-	  bufptr = buffer;
-	}
-	else
-	{
-	  status = false;
-	  _hcFileError(file, "Text without leading element or directive.");
-	}
-      }
-    }
+  html.pool       = file->pool;
+  html.events     = events;
+  html.events_ctx = ctx;
 
-  }
+  status = html_parse_file(file, &html, &parent, &stop);
 
-  if (bufptr > buffer)
+  // Close any open elements, unless a callback stopped parsing...
+  if (!html.event_stop && !html_close_nodes(&html, &parent, NULL))
+    status = false;
+
+  // Free memory...
+  while ((node = html.event_nodes) != NULL)
   {
-    // Add trailing text string...
-    if (parent)
-    {
-      *bufptr = '\0';
-      hcNodeNewString(parent, buffer);
-    }
-    else
-    {
-      status = false;
-      _hcFileError(file, "Text without leading element or directive.");
-    }
+    html.event_nodes = node->prev_sibling;
+    _hcPoolFree(html.pool, node);
   }
 
+  _hcPoolFree(html.pool, html.event_attrs);
+  _hcPoolFree(html.pool, html.event_data);
+
   return (status);
 }
 
 
 //
-// 'html_parse_attr()' - Parse an attribute.
+// 'hcHTMLParserFeed()' - Add data to a HTML push parser.
+//
+// This function adds a chunk of data to the document being parsed.  Complete
+// lines of text, elements, and comments are added to the document as soon as
+// they are available, while incomplete markup is kept until more data is added
+// or `hcHTMLParserFinish` is called.
 //
 
-static int				// O - Character or `EOF` to stop
-html_parse_attr(hc_file_t *file,	// I - File to read from
-                int       ch,		// I - Initial character
-                hc_node_t *node)	// I - HTML element node
+bool					// O - `true` to continue, `false` on error
+hcHTMLParserFeed(
+    hc_html_parser_t *parser,		// I - HTML parser
+    const void       *data,		// I - Data
+    size_t           bytes)		// I - Number of bytes
 {
-  char	name[256],			// Name string
-	value[2048],			// Value string
-	*ptr,				// Pointer into string
-	*end;				// End of string
-
-
-  // Read name...
-  ptr = name;
-  end = name + sizeof(name) - 1;
+  size_t	length;			// Length of complete data
 
-  do
-  {
-    if (ptr < end)
-      *ptr++ = (char)tolower(ch);
-    else
-      break;
-  }
-  while ((ch = hcFileGetc(file)) != EOF && ch != '=' && ch != '>' && !isspace(ch));
 
-  *ptr = '\0';
+  // Range check input...
+  if (!parser || (!data && bytes > 0) || parser->stop)
+    return (false);
 
-  if (ch == '=')
+  // Append the data to any pending data...
+  if ((parser->datalen + bytes) > parser->dataalloc)
   {
-    // Read value...
-    ptr = value;
-    end = value + sizeof(value) - 1;
+    char	*temp;			// New data buffer
+    size_t	dataalloc = parser->dataalloc ? parser->dataalloc : 1024;
+					// New allocation size
 
-    if ((ch = hcFileGetc(file)) == '\'' || ch == '\"')
-    {
-      int quote = ch;			// Quote character
+    while (dataalloc < (parser->datalen + bytes))
+      dataalloc *= 2;
 
-      while ((ch = hcFileGetc(file)) != EOF && ch != quote)
-      {
-	if (ptr < end)
-	  *ptr++ = (char)ch;
-	else
-	  break;
-      }
-    }
-    else if (!isspace(ch) && ch != '>' && ch != EOF)
+    if ((temp = _hcPoolRealloc(parser->html->pool, parser->data, dataalloc)) == NULL)
     {
-      do
-      {
-	if (ptr < end)
-	  *ptr++ = (char)ch;
-	else
-	  break;
-      }
-      while ((ch = hcFileGetc(file)) != EOF && ch != '>' && !isspace(ch));
+      parser->status = false;
+      parser->stop   = true;
+      return (false);
     }
 
-    *ptr = '\0';
-    hcNodeAttrSetNameValue(node, name, value);
-  }
-  else if (ch != EOF)
-  {
-    // Add "name=name"...
-    hcNodeAttrSetNameValue(node, name, name);
+    parser->data      = temp;
+    parser->dataalloc = dataalloc;
   }
 
-  return (ch);
+  memcpy(parser->data + parser->datalen, data, bytes);
+  parser->datalen += bytes;
+
+  // Parse whatever is complete...
+  while (!parser->stop && (length = html_scan_data(parser)) > 0)
+    html_parse_pending(parser, length);
+
+  return (!parser->stop);
 }
 
 
 //
-// 'html_parse_comment()' - Parse a comment.
+// 'hcHTMLParserFinish()' - Finish parsing and free a HTML push parser.
+//
+// This function parses any remaining data and frees the parser.
 //
 
-static bool				// O  - `true` to continue, `false` to stop
-html_parse_comment(hc_file_t *file,	// I  - File to read from
-                   hc_node_t **parent)	// IO - Parent node
+bool					// O - `true` on success, `false` on error
+hcHTMLParserFinish(
+    hc_html_parser_t *parser)		// I - HTML parser
 {
-  int	ch;				// Current character
-  char	buffer[8192],			// String buffer
-	*bufptr,			// Pointer into buffer
-	*bufend;			// End of buffer
+  bool	status;				// Parse status
 
 
-  bufptr = buffer;
-  bufend = buffer + sizeof(buffer) - 1;
+  if (!parser)
+    return (false);
 
-  while ((ch = hcFileGetc(file)) != EOF)
-  {
-    if (ch == '>' && bufptr > (buffer + 1) && bufptr[-1] == '-' && bufptr[-2] == '-')
-    {
-      // End of comment...
-      bufptr -= 2;
-      break;
-    }
-    else if (bufptr < bufend)
-      *bufptr++ = (char)ch;
-    else if (!_hcFileError(file, "Comment too long."))
-      return (false);
-    else
-      break;
-  }
+  if (!parser->stop && parser->datalen > 0)
+    html_parse_pending(parser, parser->datalen);
 
-  *bufptr = '\0';
+  status = parser->status;
 
-  hcNodeNewComment(*parent, buffer);
+  _hcPoolFree(parser->html->pool, parser->data);
+  _hcPoolFree(parser->html->pool, parser);
 
-  if (ch == EOF)
-    return (_hcFileError(file, "Unexpected end-of-file."));
-  else if (ch != '>')
-    return (_hcFileError(file, "Comment too long."));
-  else
-    return (true);
+  return (status);
 }
 
 
 //
-// 'html_parse_doctype()' - Parse a DOCTYPE element.
+// 'hcHTMLParserNew()' - Create a HTML push parser.
+//
+// This function creates a parser for incrementally loading a HTML document from
+// chunks of data, for example as they are received from a pipe or socket.  The
+// "url" argument is used for error messages and can be `NULL`.  Data is added
+// with the `hcHTMLParserFeed` function and parsing is completed with the
+// `hcHTMLParserFinish` function.
 //
 
-static bool				// O  - `true` to continue, `false` to stop
-html_parse_doctype(hc_file_t *file,	// I  - File to read from
-                   hc_html_t *html,	// I  - HTML document
-		   hc_node_t **parent)	// IO - Parent node
+hc_html_parser_t *			// O - HTML parser or `NULL` on error
+hcHTMLParserNew(hc_html_t  *html,	// I - HTML document
+                const char *url)	// I - URL or filename or `NULL`
 {
-  int	ch;				// Character from file
-  char	buffer[2048],			// String buffer
-	*bufptr,			// Pointer into buffer
-	*bufend;			// End of buffer
+  hc_html_parser_t	*parser;	// HTML parser
 
 
-  bufptr = buffer;
-  bufend = buffer + sizeof(buffer) - 1;
+  // Range check input...
+  if (!html || html->root)
+    return (NULL);
 
-  while ((ch = hcFileGetc(file)) != EOF)
+  if ((parser = _hcPoolCalloc(html->pool, 1, sizeof(hc_html_parser_t))) != NULL)
   {
-    if (!isspace(ch))
-      break;
+    parser->html         = html;
+    parser->status       = true;
+    parser->file.pool    = html->pool;
+    parser->file.url     = url ? hcPoolGetString(html->pool, url) : NULL;
+    parser->file.linenum = 1;
   }
 
-  while (ch != EOF && ch != '>')
+  return (parser);
+}
+
+
+//
+// 'html_add_attr()' - Add an attribute for the next start element event.
+//
+
+static bool				// O - `true` on success, `false` on error
+html_add_attr(hc_html_t  *html,		// I - HTML document
+              const char *name,		// I - Attribute name
+              size_t     namelen,	// I - Length of name
+              const char *value,	// I - Attribute value
+              size_t     valuelen)	// I - Length of value
+{
+  size_t	i,			// Looping var
+		needed = namelen + valuelen + 2;
+					// Bytes needed for strings
+  hc_html_attr_t *attr;			// Attribute
+  char		*data;			// Attribute strings
+
+
+  // Make room for the attribute...
+  if (html->num_event_attrs >= html->alloc_event_attrs)
   {
-    if (bufptr < bufend)
-      *bufptr++ = (char)ch;
-    else
-      break;
+    if ((attr = _hcPoolRealloc(html->pool, html->event_attrs, (html->alloc_event_attrs + 16) * sizeof(hc_html_attr_t))) == NULL)
+      return (false);
 
-    if (ch == '\'' || ch == '\"')
+    html->event_attrs       = attr;
+    html->alloc_event_attrs += 16;
+  }
+
+  if ((html->event_used + needed) > html->event_alloc)
+  {
+    size_t	alloc = 2 * (html->event_used + needed);
+					// New size of strings
+
+    // Save the string offsets before reallocating...
+    for (i = 0, attr = html->event_attrs; i < html->num_event_attrs; i ++, attr ++)
     {
-      int quote = ch;			// Quote character
+      attr->namelen  = (size_t)(attr->name - html->event_data);
+      attr->valuelen = (size_t)(attr->value - html->event_data);
+    }
 
-      while ((ch = hcFileGetc(file)) != EOF && ch != quote)
-      {
-        if (bufptr < bufend)
-          *bufptr++ = (char)ch;
-        else
-          break;
-      }
+    if ((data = _hcPoolRealloc(html->pool, html->event_data, alloc)) == NULL)
+      return (false);
+
+    for (i = 0, attr = html->event_attrs; i < html->num_event_attrs; i ++, attr ++)
+    {
+      // Strings are packed, so the next name (or the end) follows the value...
+      size_t next = (i + 1) < html->num_event_attrs ? attr[1].namelen : html->event_used;
+					// Offset of next string
+
+      attr->name     = data + attr->namelen;
+      attr->value    = data + attr->valuelen;
+      attr->namelen  = attr->valuelen - attr->namelen - 1;
+      attr->valuelen = next - (size_t)(attr->value - data) - 1;
     }
-    else
-      ch = hcFileGetc(file);
+
+    html->event_data  = data;
+    html->event_alloc = alloc;
   }
 
-  *bufptr = '\0';
+  // Copy the strings...
+  attr = html->event_attrs + html->num_event_attrs;
+  data = html->event_data + html->event_used;
 
-  if (ch == EOF)
-  {
-    _hcFileError(file, "Unexpected end-of-file.");
-    return (false);
-  }
-  else if (ch != '>')
-    _hcFileError(file, "<!DOCTYPE ...> too long.");
+  memcpy(data, name, namelen);
+  data[namelen] = '\0';
+  attr->name    = data;
+  attr->namelen = namelen;
 
-  *parent = hcHTMLNewRootNode(html, buffer);
+  data += namelen + 1;
 
-  return (*parent != NULL);
+  memcpy(data, value, valuelen);
+  data[valuelen] = '\0';
+  attr->value    = data;
+  attr->valuelen = valuelen;
+
+  html->num_event_attrs ++;
+  html->event_used += needed;
+
+  return (true);
 }
 
 
 //
-// 'html_parse_element()' - Parse an element.
+// 'html_close_nodes()' - Make an ancestor node the current parent.
+//
+// For event callbacks, the end callback is called for each element that is
+// closed and the element nodes are saved for reuse.
 //
 
 static bool				// O  - `true` to continue, `false` to stop
-html_parse_element(hc_file_t *file,	// I  - File to read from
-                   int       ch,	// I  - Initial character after '<'
-                   hc_html_t *html,	// I  - HTML document
-                   hc_node_t **parent)	// IO - Parent node
+html_close_nodes(hc_html_t *html,	// I  - HTML document
+                 hc_node_t **parent,	// IO - Parent node
+                 hc_node_t *node)	// I  - New parent node or `NULL` to close all
 {
-  char		buffer[256],		// String buffer
-		*bufptr,		// Pointer into buffer
-		*bufend;		// End of buffer
-  hc_element_t	element;		// Element index
-  hc_node_t	*node;			// New node
-  bool		close_el = ch == '/';	// Close element?
+  hc_node_t	*current;		// Current node
 
 
-  // Read the element name...
-  bufptr = buffer;
+  if (html->events)
+  {
+    while ((current = *parent) != NULL && current != node)
+    {
+      *parent               = current->parent;
+      current->next_sibling = html->free_nodes;
+      html->free_nodes      = current;
+
+      if (html->events->end_cb && !(html->events->end_cb)(html->events_ctx, current->element))
+      {
+        html->event_stop = true;
+        return (false);
+      }
+    }
+  }
+
+  *parent = node;
+
+  return (true);
+}
+
+
+//
+// 'html_grow_text()' - Grow the text buffer.
+//
+// The text buffer is only grown when text nodes are not split at newlines, so
+// that contiguous text is added as a single string node.
+//
+
+static bool				// O  - `true` if grown, `false` to add the text now
+html_grow_text(hc_html_t *html,		// I  - HTML document
+               char      **buffer,	// IO - Text buffer
+               char      **bufptr,	// IO - Pointer into buffer
+               char      **bufend)	// IO - End of buffer
+{
+  size_t	bufsize = (size_t)(*bufend - *buffer) + 1,
+					// Current size of buffer
+		used = (size_t)(*bufptr - *buffer);
+					// Bytes used in buffer
+  char		*temp;			// New buffer
+
+
+  if (html->split_text || (temp = _hcPoolRealloc(html->pool, *buffer, 2 * bufsize)) == NULL)
+    return (false);
+
+  *buffer = temp;
+  *bufptr = temp + used;
+  *bufend = temp + 2 * bufsize - 1;
+
+  return (true);
+}
+
+
+//
+// 'html_new_comment()' - Add a comment.
+//
+
+static bool				// O - `true` to continue, `false` to stop
+html_new_comment(hc_html_t  *html,	// I - HTML document
+                 hc_node_t  *parent,	// I - Parent node
+                 const char *c,		// I - Comment string
+                 size_t     clen)	// I - Length of comment string
+{
+  if (!html->events)
+    hcNodeNewComment(parent, c);
+  else if (parent && html->events->comment_cb && !(html->events->comment_cb)(html->events_ctx, c, clen))
+    html->event_stop = true;
+
+  return (!html->event_stop);
+}
+
+
+//
+// 'html_new_element()' - Add an element.
+//
+// For event callbacks, the returned node only has the element and parent
+// values set, and the "prev_sibling" value links all of the nodes that have
+// been allocated.  The start callback is called by `html_start_element` once
+// the attributes have been parsed.
+//
+
+static hc_node_t *			// O - New node or `NULL` on error
+html_new_element(hc_html_t    *html,	// I - HTML document
+                 hc_node_t    *parent,	// I - Parent node
+                 hc_element_t element)	// I - Element
+{
+  hc_node_t	*node;			// New node
+
+
+  if (!html->events)
+    return (hcNodeNewElement(parent, element));
+
+  // Validate the element like hcHTMLNewRootNode and hcNodeNewElement...
+  if (element < HC_ELEMENT_DOCTYPE || element >= HC_ELEMENT_MAX || (element == HC_ELEMENT_DOCTYPE) != (parent == NULL))
+    return (NULL);
+
+  // Reuse a closed node or allocate a new one...
+  if ((node = html->free_nodes) != NULL)
+  {
+    html->free_nodes = node->next_sibling;
+  }
+  else if ((node = _hcPoolMalloc(html->pool, sizeof(hc_node_t))) != NULL)
+  {
+    node->prev_sibling = html->event_nodes;
+    html->event_nodes  = node;
+  }
+  else
+  {
+    return (NULL);
+  }
+
+  node->element      = element;
+  node->parent       = parent;
+  node->next_sibling = NULL;
+
+  return (node);
+}
+
+
+//
+// 'html_new_root()' - Add the root node.
+//
+
+static hc_node_t *			// O - Root node or `NULL` to stop
+html_new_root(hc_html_t  *html,		// I - HTML document
+              const char *doctype)	// I - DOCTYPE value
+{
+  hc_node_t	*node;			// Root node
+
+
+  if (!html->events)
+    return (hcHTMLNewRootNode(html, doctype));
+
+  if ((node = html_new_element(html, NULL, HC_ELEMENT_DOCTYPE)) == NULL)
+    return (NULL);
+
+  html->root = node;
+
+  if (!html_add_attr(html, "", 0, doctype, strlen(doctype)) || !html_start_element(html, node))
+    return (NULL);
+
+  return (node);
+}
+
+
+//
+// 'html_new_string()' - Add a text string.
+//
+
+static bool				// O - `true` to continue, `false` to stop
+html_new_string(hc_html_t  *html,	// I - HTML document
+                hc_node_t  *parent,	// I - Parent node
+                const char *s,		// I - Text string
+                size_t     slen)	// I - Length of text string
+{
+  if (!html->events)
+    _hcNodeNewStringLen(parent, s, slen);
+  else if (html->events->text_cb && !(html->events->text_cb)(html->events_ctx, s, slen))
+    html->event_stop = true;
+
+  return (!html->event_stop);
+}
+
+
+//
+// 'html_parse_attr()' - Parse an attribute.
+//
+
+static int				// O - Character or `EOF` to stop
+html_parse_attr(hc_file_t *file,	// I - File to read from
+                int       ch,		// I - Initial character
+                hc_html_t *html,	// I - HTML document
+                hc_node_t *node)	// I - HTML element node
+{
+  char	name[256],			// Name string
+	value[2048],			// Value buffer
+	*ptr,				// Pointer into string
+	*end;				// End of string
+  size_t	namelen;			// Length of name string
+  unsigned	bhash = 0,		// Bucket hash of name
+		shash = 0;		// Slot hash of name
+  size_t	slot;			// Slot in attribute hash table
+  int		attr;			// Known attribute index
+  const char	*valptr = value;	// Value string
+  size_t	vallen;			// Length of value string
+  const char	*data;			// Scanned data
+  size_t	datalen;		// Length of scanned data
+  const char	*pooled = NULL;		// Pooled attribute name
+  char		ref[16];		// Decoded character reference
+  size_t	reflen;			// Length of character reference
+
+
+  // Read and hash name, truncating long names...
+  ptr = name;
+  end = name + sizeof(name) - 1;
+
+  do
+  {
+    if (ptr < end)
+    {
+      *ptr  = (char)tolower(ch);
+      bhash = (bhash * 33 + (unsigned)(*ptr & 255)) & 0xffffff;
+      shash = (shash * 31 + (unsigned)(*ptr & 255)) & 0xffffff;
+      ptr ++;
+    }
+  }
+  while ((ch = _hcFileGetc(file)) != EOF && ch != '=' && ch != '>' && !isspace(ch));
+
+  namelen = (size_t)(ptr - name);
+  *ptr    = '\0';
+
+  // Use the pooled string for known attribute names, comparing the length
+  // before the name.  Event callbacks get all attribute names from the
+  // per-element buffer instead (see hcHTMLParse)...
+  slot = (shash + attr_disp[bhash % HC_ATTR_BUCKETS]) % HC_ATTR_SLOTS;
+
+  if (!html->events && (attr = attr_slots[slot].attr) >= 0 && attr_slots[slot].length == namelen && !memcmp(name, html_attrs[attr], namelen))
+  {
+    if ((pooled = html->attrs[attr]) == NULL)
+      pooled = html->attrs[attr] = hcPoolGetStringLen(html->pool, html_attrs[attr], namelen);
+  }
+
+  if (ch == '=')
+  {
+    // Read value, truncating long values...
+    ptr = value;
+    end = value + sizeof(value) - 1;
+
+    if ((ch = _hcFileGetc(file)) == '\'' || ch == '\"')
+    {
+      int	quote = ch;		// Quote character
+      const char *delims = quote == '\'' ? "'&" : "\"&";
+					// Delimiters for value
+
+      // Use the value in the file buffer if it has no character references...
+      datalen = (size_t)(end - ptr);
+
+      if (hcFileScan(file, delims, &data, &datalen) && file->bufptr < file->bufend && *file->bufptr == quote)
+      {
+        valptr = data;
+        ch     = *(file->bufptr)++;
+      }
+      else
+      {
+        // Otherwise copy the value, decoding character references...
+        if (datalen > 0)
+        {
+          memcpy(ptr, data, datalen);
+          ptr += datalen;
+        }
+
+	while ((ch = _hcFileGetc(file)) != EOF && ch != quote)
+	{
+	  if (ch == '&')
+	  {
+	    // Decode character reference...
+	    if ((reflen = html_parse_ref(file, true, ref)) <= (size_t)(end - ptr))
+	    {
+	      memcpy(ptr, ref, reflen);
+	      ptr += reflen;
+	    }
+	  }
+	  else if (ptr < end)
+	  {
+	    *ptr++ = (char)ch;
+	  }
+
+	  datalen = (size_t)(end - ptr);
+
+	  if (datalen > 0 && hcFileScan(file, delims, &data, &datalen) && datalen > 0)
+	  {
+	    memcpy(ptr, data, datalen);
+	    ptr += datalen;
+	  }
+	}
+      }
+    }
+    else if (!isspace(ch) && ch != '>' && ch != EOF)
+    {
+      // Use the value in the file buffer if it has no character references...
+      _hcFileUngetc(file, ch);
+
+      datalen = (size_t)(end - ptr);
+
+      if (hcFileScan(file, "\t\n\v\f\r &>", &data, &datalen) && file->bufptr < file->bufend && (*file->bufptr == '>' || isspace(*file->bufptr)))
+      {
+        valptr = data;
+        ch     = *(file->bufptr)++;
+      }
+      else
+      {
+        // Otherwise copy the value, decoding character references...
+        if (datalen > 0)
+        {
+          memcpy(ptr, data, datalen);
+          ptr += datalen;
+        }
+
+	while ((ch = _hcFileGetc(file)) != EOF && ch != '>' && !isspace(ch))
+	{
+	  if (ch == '&')
+	  {
+	    // Decode character reference...
+	    if ((reflen = html_parse_ref(file, true, ref)) <= (size_t)(end - ptr))
+	    {
+	      memcpy(ptr, ref, reflen);
+	      ptr += reflen;
+	    }
+	  }
+	  else if (ptr < end)
+	  {
+	    *ptr++ = (char)ch;
+	  }
+	}
+      }
+    }
+
+    vallen = valptr == value ? (size_t)(ptr - value) : datalen;
+
+    if (html->events)
+    {
+      if (node)
+        html_add_attr(html, name, namelen, valptr, vallen);
+    }
+    else if (pooled && node)
+      _hcDictSetPooledKeyValue(&node->value.element.attrs, pooled, hcPoolGetStringLen(html->pool, valptr, vallen));
+    else
+      hcNodeAttrSetNameValueLen(node, name, namelen, valptr, vallen);
+  }
+  else if (ch != EOF)
+  {
+    // Add "name=name"...
+    if (html->events)
+    {
+      if (node)
+        html_add_attr(html, name, namelen, name, namelen);
+    }
+    else if (pooled && node)
+      _hcDictSetPooledKeyValue(&node->value.element.attrs, pooled, pooled);
+    else
+      hcNodeAttrSetNameValueLen(node, name, namelen, name, namelen);
+  }
+
+  return (ch);
+}
+
+
+//
+// 'html_parse_comment()' - Parse a comment.
+//
+
+static bool				// O  - `true` to continue, `false` to stop
+html_parse_comment(hc_file_t *file,	// I  - File to read from
+                   hc_html_t *html,	// I  - HTML document
+                   hc_node_t **parent)	// IO - Parent node
+{
+  int	ch;				// Current character
+  char	buffer[8192],			// String buffer
+	*bufptr,			// Pointer into buffer
+	*bufend;			// End of buffer
+
+
+  bufptr = buffer;
+  bufend = buffer + sizeof(buffer) - 1;
+
+  while ((ch = _hcFileGetc(file)) != EOF)
+  {
+    if (ch == '>' && bufptr > (buffer + 1) && bufptr[-1] == '-' && bufptr[-2] == '-')
+    {
+      // End of comment...
+      bufptr -= 2;
+      break;
+    }
+    else if (bufptr < bufend)
+    {
+      const char	*data;		// Comment data
+      size_t		datalen;	// Length of comment data
+
+      *bufptr++ = (char)ch;
+      datalen   = (size_t)(bufend - bufptr);
+
+      if (hcFileScan(file, ">", &data, &datalen) && datalen > 0)
+      {
+        memcpy(bufptr, data, datalen);
+        bufptr += datalen;
+      }
+    }
+    else
+    {
+      // Skip the rest of a long comment...
+      int dashes = bufptr[-1] != '-' ? 0 : bufptr[-2] != '-' ? 1 : 2;
+					// Number of dashes before '>'
+
+      if (!_hcFileError(file, "Comment too long."))
+        return (false);
+
+      for (; ch != EOF && (ch != '>' || dashes < 2); ch = _hcFileGetc(file))
+      {
+        if (ch != '-')
+          dashes = 0;
+        else if (dashes < 2)
+          dashes ++;
+      }
+      break;
+    }
+  }
+
+  *bufptr = '\0';
+
+  if (!html_new_comment(html, *parent, buffer, (size_t)(bufptr - buffer)))
+    return (false);
+
+  if (ch == EOF)
+    return (_hcFileError(file, "Unexpected end-of-file."));
+  else
+    return (true);
+}
+
+
+//
+// 'html_parse_doctype()' - Parse a DOCTYPE element.
+//
+
+static bool				// O  - `true` to continue, `false` to stop
+html_parse_doctype(hc_file_t *file,	// I  - File to read from
+                   hc_html_t *html,	// I  - HTML document
+		   hc_node_t **parent)	// IO - Parent node
+{
+  int	ch;				// Character from file
+  char	buffer[2048],			// String buffer
+	*bufptr,			// Pointer into buffer
+	*bufend;			// End of buffer
+  bool	truncated = false;		// Was the value truncated?
+
+
+  bufptr = buffer;
+  bufend = buffer + sizeof(buffer) - 1;
+
+  while ((ch = _hcFileGetc(file)) != EOF)
+  {
+    if (!isspace(ch))
+      break;
+  }
+
+  // Read the value, skipping anything that doesn't fit...
+  while (ch != EOF && ch != '>')
+  {
+    if (bufptr < bufend)
+      *bufptr++ = (char)ch;
+    else
+      truncated = true;
+
+    if (ch == '\'' || ch == '\"')
+    {
+      int quote = ch;			// Quote character
+
+      while ((ch = _hcFileGetc(file)) != EOF && ch != quote)
+      {
+        if (bufptr < bufend)
+          *bufptr++ = (char)ch;
+        else
+          truncated = true;
+      }
+    }
+    else
+      ch = _hcFileGetc(file);
+  }
+
+  *bufptr = '\0';
+
+  if (ch == EOF)
+  {
+    _hcFileError(file, "Unexpected end-of-file.");
+    return (false);
+  }
+  else if (truncated)
+    _hcFileError(file, "<!DOCTYPE ...> too long.");
+
+  *parent = html_new_root(html, buffer);
+
+  return (*parent != NULL);
+}
+
+
+//
+// 'html_parse_element()' - Parse an element.
+//
+
+static bool				// O  - `true` to continue, `false` to stop
+html_parse_element(hc_file_t *file,	// I  - File to read from
+                   int       ch,	// I  - Initial character after '<'
+                   hc_html_t *html,	// I  - HTML document
+                   hc_node_t **parent)	// IO - Parent node
+{
+  char		buffer[256],		// String buffer
+		*bufptr,		// Pointer into buffer
+		*bufend;		// End of buffer
+  hc_element_t	element;		// Element index
+  hc_node_t	*node;			// New node
+  bool		close_el = ch == '/';	// Close element?
+
+
+  // Read the element name...
+  bufptr = buffer;
   bufend = buffer + sizeof(buffer) - 1;
   if (!close_el)
     *bufptr++ = (char)ch;
 
-  while ((ch = hcFileGetc(file)) != EOF)
+  while ((ch = _hcFileGetc(file)) != EOF)
+  {
+    if (isspace(ch) || ch == '>' || ch == '/')
+      break;
+    else if (bufptr < bufend)
+      *bufptr++ = (char)ch;
+    else if (!_hcFileError(file, "Element name too long."))
+      return (false);
+    else
+      break;
+
+    if ((bufptr - buffer) == 3 && !memcmp(buffer, "!--", 3))
+    {
+      // Comment without whitespace, pretend we got some...
+      ch = ' ';
+      break;
+    }
+  }
+
+  if (ch == EOF)
+  {
+    _hcFileError(file, "Unexpected end-of-file.");
+    return (false);
+  }
+
+  *bufptr = '\0';
+
+  // Convert the name to an enum...
+  if (isspace(ch) || ch == '>' || ch == '/')
+  {
+    element = hcElementValue(buffer);
+
+    if (element == HC_ELEMENT_UNKNOWN && !_hcFileError(file, "Unknown element '%s'.", buffer))
+      return (false);
+  }
+  else
+  {
+    _hcFileUngetc(file, ch);
+    element = HC_ELEMENT_UNKNOWN;
+  }
+
+  // Parse unknown, comment, and doctype elements accordingly...
+  if (element == HC_ELEMENT_DOCTYPE)
+  {
+    if (close_el)
+    {
+      _hcFileError(file, "Invalid </!DOCTYPE> seem.");
+      return (false);
+    }
+    else if (html->root)
+    {
+      _hcFileError(file, "Duplicate <!DOCTYPE> seen.");
+      return (false);
+    }
+
+    return (html_parse_doctype(file, html, parent));
+  }
+  else if (!*parent)
+  {
+    if (!_hcFileError(file, "Missing <!DOCTYPE html> directive."))
+      return (false);
+
+    if ((*parent = html_new_root(html, "html")) == NULL)
+      return (false);
+  }
+  else if (element == HC_ELEMENT_UNKNOWN)
+  {
+    // Keep the character after the name with the unknown markup so that
+    // "<foo>" doesn't consume the following markup...
+    if (isspace(ch) || ch == '>' || ch == '/')
+      _hcFileUngetc(file, ch);
+
+    if (close_el)
+    {
+      char	unk[257];		// Unknown value
+
+      snprintf(unk, sizeof(unk), "/%s", buffer);
+      return (html_parse_unknown(file, html, parent, unk));
+    }
+    else
+    {
+      return (html_parse_unknown(file, html, parent, buffer));
+    }
+  }
+  else if (element == HC_ELEMENT_COMMENT)
   {
-    if (isspace(ch) || ch == '>' || ch == '/')
-      break;
-    else if (bufptr < bufend)
-      *bufptr++ = (char)ch;
-    else if (!_hcFileError(file, "Element name too long."))
+    return (html_parse_comment(file, html, parent));
+  }
+
+  // Otherwise add the element (or close it) in the right place...
+  if (close_el)
+  {
+    // Close the specified element...
+    if (ch != '>' && !_hcFileError(file, "Invalid </%s> element.", buffer))
       return (false);
-    else
-      break;
 
-    if ((bufptr - buffer) == 3 && !memcmp(buffer, "!--", 3))
+    for (node = *parent; node; node = node->parent)
     {
-      // Comment without whitespace, pretend we got some...
-      ch = ' ';
-      break;
+      if (node->element == element)
+        break;
     }
+
+    if (node)
+      return (html_close_nodes(html, parent, node->parent));
+    else if (!_hcFileError(file, "Missing <%s> for </%s> element.", buffer, buffer))
+      return (false);
+
+    return (true);
   }
 
-  if (ch == EOF)
+  // HTML doesn't enforce strict open/close markup semantics, so allow <p>,
+  // <li>, etc. to close out like markup...
+  if (html_issuper(element))
   {
-    _hcFileError(file, "Unexpected end-of-file.");
-    return (false);
+    for (node = *parent; node; node = node->parent)
+    {
+      if (html_istentry(node->element))
+	break;
+    }
+  }
+  else if (html_islist(element))
+  {
+    for (node = *parent; node; node = node->parent)
+    {
+      if (html_isblock(node->element) || html_islentry(node->element) || html_istentry(node->element) || html_issuper(node->element))
+	break;
+    }
+  }
+  else if (html_islentry(element))
+  {
+    for (node = *parent; node; node = node->parent)
+    {
+      if (html_islist(node->element))
+	break;
+    }
   }
+  else if (html_isblock(element))
+  {
+    for (node = *parent; node; node = node->parent)
+    {
+      if (html_isblock(node->element))
+      {
+        node = node->parent;
+	break;
+      }
+      else if (html_istentry(node->element) || html_islist(node->element) || html_islentry(node->element) || html_issuper(node->element))
+      {
+	break;
+      }
+    }
+  }
+  else if (element == HC_ELEMENT_THEAD || element == HC_ELEMENT_TBODY || element == HC_ELEMENT_TFOOT)
+  {
+    for (node = *parent; node; node = node->parent)
+    {
+      if (node->element == HC_ELEMENT_TABLE)
+	break;
+    }
+  }
+  else if (html_istentry(element))
+  {
+    for (node = *parent; node; node = node->parent)
+    {
+      if (html_istentry(node->element))
+      {
+        node = node->parent;
+	break;
+      }
+      else if (node->element == HC_ELEMENT_TR)
+      {
+        break;
+      }
+      else if (node->element == HC_ELEMENT_TABLE || html_istable(node->element))
+      {
+        if (!_hcFileError(file, "No <tr> element before <%s> element.", buffer))
+          return (false);
 
-  *bufptr = '\0';
+        if ((node = html_new_element(html, *parent, HC_ELEMENT_TR)) != NULL)
+        {
+          // The new row is the parent...
+          if (!html_start_element(html, node))
+            return (false);
 
-  // Convert the name to an enum...
-  if (isspace(ch) || ch == '>' || ch == '/')
+          *parent = node;
+          node    = NULL;
+        }
+        break;
+      }
+    }
+  }
+  else
   {
-    element = hcElementValue(buffer);
+    // No new parent...
+    node = NULL;
+  }
 
-    if (element == HC_ELEMENT_UNKNOWN && !_hcFileError(file, "Unknown element '%s'.", buffer))
-      return (false);
+  if (node && !html_close_nodes(html, parent, node))
+    return (false);
+
+  node = html_new_element(html, *parent, element);
+
+  if (node && ch != '/' && !html_isleaf(element))
+    *parent = node;
+
+  while (ch != '>' && ch != EOF)
+  {
+    while ((ch = _hcFileGetc(file)) != EOF)
+    {
+      if (!isspace(ch))
+        break;
+    }
+
+    if (ch != '>')
+      ch = html_parse_attr(file, ch, html, node);
   }
-  else
+
+  if (!html_start_element(html, node))
+    return (false);
+
+  // Close leaf elements right away...
+  if (node && node != *parent && !html_close_nodes(html, &node, *parent))
+    return (false);
+
+  return (ch == '>');
+}
+
+
+//
+// 'html_parse_file()' - Parse text and markup from a file.
+//
+
+static bool				// O  - `true` on success, `false` on error
+html_parse_file(hc_file_t *file,	// I  - File to read from
+                hc_html_t *html,	// I  - HTML document
+                hc_node_t **parent,	// IO - Parent node
+                bool      *stop)	// O  - `true` if parsing was stopped
+{
+  bool		status = true;		// Load status
+  int		ch;			// Current character
+  char		*buffer,		// Text buffer
+		*bufptr,		// Pointer into buffer
+		*bufend;		// End of buffer
+
+
+  if ((buffer = _hcPoolMalloc(html->pool, 8192)) == NULL)
   {
-    hcFileUngetc(file, ch);
-    element = HC_ELEMENT_UNKNOWN;
+    *stop = true;
+    return (false);
   }
 
-  // Parse unknown, comment, and doctype elements accordingly...
-  if (element == HC_ELEMENT_DOCTYPE)
+  bufptr = buffer;
+  bufend = buffer + 8191;
+
+  while ((ch = _hcFileGetc(file)) != EOF)
   {
-    if (close_el)
+    if (ch == '<')
     {
-      _hcFileError(file, "Invalid </!DOCTYPE> seem.");
-      return (false);
+      // Read a HTML element...
+      ch = _hcFileGetc(file);
+
+      if (isspace(ch) || ch == '=' || ch == '<')
+      {
+        // Sigh...  "<" followed by anything but an element name is invalid
+        // HTML, but many pages are still broken.  Log it and abort if the error
+        // callback says to...
+        if (!_hcFileError(file, "Unquoted '<'."))
+        {
+          status = false;
+          *stop  = true;
+          break;
+        }
+
+        if (bufptr >= (bufend - 1) && !html_grow_text(html, &buffer, &bufptr, &bufend))
+        {
+	  // Add text string...
+	  if (*parent)
+	  {
+	    *bufptr = '\0';
+	    *stop   = !html_new_string(html, *parent, buffer, (size_t)(bufptr - buffer));
+	    bufptr  = buffer;
+
+	    if (*stop)
+	    {
+	      status = false;
+	      break;
+	    }
+	  }
+	  else
+	  {
+	    status = false;
+	    *stop  = true;
+	    _hcFileError(file, "Text without leading element or directive.");
+	    break;
+	  }
+        }
+
+        *bufptr++ = '<';
+
+	if (ch == '<')
+	  _hcFileUngetc(file, ch);
+        else
+          *bufptr++ = (char)ch;
+      }
+      else
+      {
+        // Got the first character of an element name, add any pending text and
+        // then parse the element...
+	if (bufptr > buffer)
+	{
+	  // Add text string...
+	  if (*parent)
+	  {
+	    *bufptr = '\0';
+	    *stop   = !html_new_string(html, *parent, buffer, (size_t)(bufptr - buffer));
+	    bufptr  = buffer;
+
+	    if (*stop)
+	    {
+	      status = false;
+	      break;
+	    }
+	  }
+	  else
+	  {
+	    status = false;
+	    *stop  = true;
+	    _hcFileError(file, "Text without leading element or directive.");
+	    break;
+	  }
+	}
+
+	if (!(status = html_parse_element(file, ch, html, parent)))
+	{
+	  *stop = true;
+	  break;
+	}
+      }
     }
-    else if (html->root)
+    else
     {
-      _hcFileError(file, "Duplicate <!DOCTYPE> seen.");
-      return (false);
+      if (ch == '&')
+      {
+        // Decode character reference...
+        char	ref[16];		// Decoded character reference
+        size_t	reflen = html_parse_ref(file, false, ref);
+					// Length of character reference
+
+        if (reflen > (size_t)(bufend - bufptr) && !html_grow_text(html, &buffer, &bufptr, &bufend))
+        {
+	  // Add text string...
+	  if (*parent)
+	  {
+	    *bufptr = '\0';
+	    *stop   = !html_new_string(html, *parent, buffer, (size_t)(bufptr - buffer));
+	    bufptr  = buffer;
+
+	    if (*stop)
+	    {
+	      status = false;
+	      break;
+	    }
+	  }
+	  else
+	  {
+	    status = false;
+	    _hcFileError(file, "Text without leading element or directive.");
+	  }
+        }
+
+        if (reflen <= (size_t)(bufend - bufptr))
+        {
+          memcpy(bufptr, ref, reflen);
+          bufptr += reflen;
+        }
+      }
+      else if (bufptr < bufend)
+      {
+        *bufptr++ = (char)ch;
+      }
+
+      if ((ch != '\n' || !html->split_text) && bufptr < bufend)
+      {
+        // Copy the rest of the text up to the next element, reference, or
+        // newline...
+        const char	*data;		// Text data
+        size_t		datalen = (size_t)(bufend - bufptr);
+					// Length of text data
+
+        if (hcFileScan(file, html->split_text ? "<&\n" : "<&", &data, &datalen) && datalen > 0)
+        {
+          memcpy(bufptr, data, datalen);
+          bufptr += datalen;
+        }
+      }
+
+      if ((ch == '\n' && html->split_text) || (bufptr >= bufend && !html_grow_text(html, &buffer, &bufptr, &bufend)))
+      {
+	if (*parent)
+	{
+	  *bufptr = '\0';
+	  *stop   = !html_new_string(html, *parent, buffer, (size_t)(bufptr - buffer));
+	  bufptr  = buffer;
+
+	  if (*stop)
+	  {
+	    status = false;
+	    break;
+	  }
+	}
+	else
+	{
+	  status = false;
+	  _hcFileError(file, "Text without leading element or directive.");
+	}
+      }
     }
 
-    return (html_parse_doctype(file, html, parent));
   }
-  else if (!*parent)
-  {
-    if (!_hcFileError(file, "Missing <!DOCTYPE html> directive."))
-      return (false);
 
-    *parent = hcHTMLNewRootNode(html, "html");
-  }
-  else if (element == HC_ELEMENT_UNKNOWN)
+  if (bufptr > buffer)
   {
-    if (close_el)
+    // Add trailing text string...
+    if (*parent)
     {
-      char	unk[257];		// Unknown value
+      *bufptr = '\0';
 
-      snprintf(unk, sizeof(unk), "/%s", buffer);
-      return (html_parse_unknown(file, parent, unk));
+      if (!html_new_string(html, *parent, buffer, (size_t)(bufptr - buffer)))
+      {
+        status = false;
+        *stop  = true;
+      }
     }
     else
     {
-      return (html_parse_unknown(file, parent, buffer));
+      status = false;
+      _hcFileError(file, "Text without leading element or directive.");
     }
   }
-  else if (element == HC_ELEMENT_COMMENT)
-  {
-    return (html_parse_comment(file, parent));
-  }
 
-  // Otherwise add the element (or close it) in the right place...
-  if (close_el)
+  _hcPoolFree(html->pool, buffer);
+
+  return (status);
+}
+
+
+//
+// 'html_parse_pending()' - Parse complete data in a HTML push parser.
+//
+
+static void
+html_parse_pending(
+    hc_html_parser_t *parser,		// I - HTML parser
+    size_t           length)		// I - Length of complete data
+{
+  size_t	used;			// Number of bytes used
+
+
+  // Point the parser's file at the complete data and parse it...
+  parser->file.buffer  = (const _hc_uchar_t *)parser->data;
+  parser->file.bufptr  = parser->file.buffer;
+  parser->file.bufend  = parser->file.buffer + length;
+  parser->file.lineptr = parser->file.buffer;
+
+  if (!html_parse_file(&parser->file, parser->html, &parser->parent, &parser->stop))
+    parser->status = false;
+
+  // Count lines and remove the data that was used...
+  _hcFileGetLine(&parser->file);
+
+  used = (size_t)(parser->file.bufptr - parser->file.buffer);
+
+  if (used < parser->datalen)
+    memmove(parser->data, parser->data + used, parser->datalen - used);
+
+  parser->datalen -= used;
+  parser->scanpos -= used;
+  parser->file.buffer  = NULL;
+  parser->file.bufptr  = NULL;
+  parser->file.bufend  = NULL;
+  parser->file.lineptr = NULL;
+}
+
+
+//
+// 'html_parse_ref()' - Parse and decode a character reference.
+//
+// This function is called after reading the "&" character.  Named references
+// are matched by walking the sorted `html_refs` table as a trie, narrowing the
+// range of names sharing the current prefix with each character and
+// remembering the longest complete name, so "&notit;" is decoded as "¬it;".
+// Numeric references are decoded as UTF-8.  Anything that is not a valid
+// reference is copied as-is.
+//
+
+static size_t				// O - Number of bytes in buffer
+html_parse_ref(hc_file_t *file,		// I - File to read from
+               bool      attr,		// I - In an attribute value?
+               char      *buffer)	// I - Buffer for text (at least 16 bytes)
+{
+  int		ch;			// Current character
+  char		*bufptr = buffer;	// Pointer into buffer
+  size_t	depth,			// Number of name characters
+		first,			// First matching name
+		last,			// Last matching name + 1
+		left,			// Left side of search
+		right,			// Right side of search
+		current,		// Current name
+		match = 0,		// Longest complete name
+		matchlen = 0,		// Length of longest complete name
+		textlen;		// Length of decoded text
+
+
+  *bufptr++ = '&';
+
+  if ((ch = _hcFileGetc(file)) == '#')
   {
-    // Close the specified element...
-    if (ch != '>' && !_hcFileError(file, "Invalid </%s> element.", buffer))
-      return (false);
+    // Numeric reference...
+    unsigned	base = 10,		// Number base
+		digit,			// Current digit
+		value = 0;		// Character value
+    bool	digits = false;		// Got any digits?
 
-    for (node = *parent; node; node = node->parent)
+    *bufptr++ = '#';
+
+    if ((ch = _hcFileGetc(file)) == 'x' || ch == 'X')
     {
-      if (node->element == element)
+      *bufptr++ = (char)ch;
+      base      = 16;
+      ch        = _hcFileGetc(file);
+    }
+
+    for (; ch != EOF; ch = _hcFileGetc(file))
+    {
+      if (ch >= '0' && ch <= '9')
+        digit = (unsigned)(ch - '0');
+      else if (base == 16 && ch >= 'a' && ch <= 'f')
+        digit = (unsigned)(ch - 'a' + 10);
+      else if (base == 16 && ch >= 'A' && ch <= 'F')
+        digit = (unsigned)(ch - 'A' + 10);
+      else
         break;
+
+      digits = true;
+
+      if (value < 0x110000)
+        value = value * base + digit;
     }
 
-    if (node)
-      *parent = node->parent;
-    else if (!_hcFileError(file, "Missing <%s> for </%s> element.", buffer, buffer))
-      return (false);
+    if (!digits)
+    {
+      // "&#" or "&#x" without digits...
+      _hcFileUngetc(file, ch);
+      return ((size_t)(bufptr - buffer));
+    }
 
-    return (true);
-  }
+    if (ch != ';')
+      _hcFileUngetc(file, ch);
 
-  // HTML doesn't enforce strict open/close markup semantics, so allow <p>,
-  // <li>, etc. to close out like markup...
-  if (html_issuper(element))
-  {
-    for (node = *parent; node; node = node->parent)
+    // Map invalid characters...
+    if (value >= 0x80 && value < 0xa0 && html_cp1252[value - 0x80])
+      value = html_cp1252[value - 0x80];
+    else if (!value || value > 0x10ffff || (value >= 0xd800 && value < 0xe000))
+      value = 0xfffd;
+
+    // Encode as UTF-8...
+    bufptr = buffer;
+
+    if (value < 0x80)
     {
-      if (html_istentry(node->element))
-	break;
+      *bufptr++ = (char)value;
     }
-  }
-  else if (html_islist(element))
-  {
-    for (node = *parent; node; node = node->parent)
+    else if (value < 0x800)
     {
-      if (html_isblock(node->element) || html_islentry(node->element) || html_istentry(node->element) || html_issuper(node->element))
-	break;
+      *bufptr++ = (char)(0xc0 | (value >> 6));
+      *bufptr++ = (char)(0x80 | (value & 0x3f));
     }
-  }
-  else if (html_islentry(element))
-  {
-    for (node = *parent; node; node = node->parent)
+    else if (value < 0x10000)
     {
-      if (html_islist(node->element))
-	break;
+      *bufptr++ = (char)(0xe0 | (value >> 12));
+      *bufptr++ = (char)(0x80 | ((value >> 6) & 0x3f));
+      *bufptr++ = (char)(0x80 | (value & 0x3f));
     }
-  }
-  else if (html_isblock(element))
-  {
-    for (node = *parent; node; node = node->parent)
+    else
     {
-      if (html_isblock(node->element))
-      {
-        node = node->parent;
-	break;
-      }
-      else if (html_istentry(node->element) || html_islist(node->element) || html_islentry(node->element) || html_issuper(node->element))
-      {
-	break;
-      }
+      *bufptr++ = (char)(0xf0 | (value >> 18));
+      *bufptr++ = (char)(0x80 | ((value >> 12) & 0x3f));
+      *bufptr++ = (char)(0x80 | ((value >> 6) & 0x3f));
+      *bufptr++ = (char)(0x80 | (value & 0x3f));
     }
+
+    return ((size_t)(bufptr - buffer));
   }
-  else if (element == HC_ELEMENT_THEAD || element == HC_ELEMENT_TBODY || element == HC_ELEMENT_TFOOT)
+
+  // Named reference...
+  for (depth = 0, first = 0, last = sizeof(html_refs) / sizeof(html_refs[0]); ch != EOF && isalnum(ch); depth ++, ch = _hcFileGetc(file))
   {
-    for (node = *parent; node; node = node->parent)
+    // Find the range of names with this character...
+    for (left = first, right = last; left < right;)
     {
-      if (node->element == HC_ELEMENT_TABLE)
-	break;
+      current = (left + right) / 2;
+
+      if ((html_refs[current].name[depth] & 255) < ch)
+        left = current + 1;
+      else
+        right = current;
     }
-  }
-  else if (html_istentry(element))
-  {
-    for (node = *parent; node; node = node->parent)
+
+    first = left;
+
+    for (right = last; left < right;)
     {
-      if (html_istentry(node->element))
-      {
-        node = node->parent;
-	break;
-      }
-      else if (node->element == HC_ELEMENT_TR)
-      {
-        break;
-      }
-      else if (node->element == HC_ELEMENT_TABLE || html_istable(node->element))
-      {
-        if (!_hcFileError(file, "No <tr> element before <%s> element.", buffer))
-          return (false);
+      current = (left + right) / 2;
 
-        node = hcNodeNewElement(*parent, HC_ELEMENT_TR);
-        break;
-      }
+      if ((html_refs[current].name[depth] & 255) <= ch)
+        left = current + 1;
+      else
+        right = current;
     }
-  }
-  else
-  {
-    // No new parent...
-    node = NULL;
-  }
 
-  if (node)
-    *parent = node;
+    last = left;
 
-  node = hcNodeNewElement(*parent, element);
+    if (first >= last)
+      break;				// No longer matches a name
 
-  if (ch != '/' && !html_isleaf(element))
-    *parent = node;
+    *bufptr++ = (char)ch;
 
-  while (ch != '>' && ch != EOF)
-  {
-    while ((ch = hcFileGetc(file)) != EOF)
+    // The first name in the range is the shortest, so see if it is complete...
+    if (!html_refs[first].name[depth + 1])
     {
-      if (!isspace(ch))
-        break;
+      match    = first;
+      matchlen = depth + 1;
     }
+  }
 
-    if (ch != '>')
-      ch = html_parse_attr(file, ch, node);
+  // Decode the longest complete name; in an attribute value a name without a
+  // trailing semicolon is not a reference when it is followed by '=' or an
+  // alphanumeric character...
+  if (matchlen == 0 || (attr && (matchlen < depth || (ch != ';' && (ch == '=' || isalnum(ch))))))
+  {
+    _hcFileUngetc(file, ch);
+    return ((size_t)(bufptr - buffer));	// No match, copy as-is
   }
 
-  return (ch == '>');
+  if (matchlen < depth || ch != ';')
+    _hcFileUngetc(file, ch);
+
+  // Copy the decoded text followed by any characters after the name...
+  depth   = (size_t)(bufptr - buffer) - matchlen - 1;
+  textlen = strlen(html_refs[match].text);
+
+  memmove(buffer + textlen, buffer + matchlen + 1, depth);
+  memcpy(buffer, html_refs[match].text, textlen);
+
+  return (textlen + depth);
 }
 
 
@@ -591,6 +1868,7 @@ html_parse_element(hc_file_t *file,	// I  - File to read from
 
 static bool				// O  - `true` to continue, `false` to stop
 html_parse_unknown(hc_file_t  *file,	// I  - File to read from
+                   hc_html_t  *html,	// I  - HTML document
                    hc_node_t  **parent,	// IO - Parent node
                    const char *unk)	// I  - Start of unknown markup
 {
@@ -598,6 +1876,7 @@ html_parse_unknown(hc_file_t  *file,	// I  - File to read from
   char	buffer[2048],			// String buffer
 	*bufptr,			// Pointer into buffer
 	*bufend;			// End of buffer
+  bool	truncated = false;		// Was the markup truncated?
 
 
   strncpy(buffer, unk, sizeof(buffer) - 1);
@@ -606,29 +1885,32 @@ html_parse_unknown(hc_file_t  *file,	// I  - File to read from
   bufptr = buffer + strlen(buffer);
   bufend = buffer + sizeof(buffer) - 1;
 
-  while ((ch = hcFileGetc(file)) != EOF && ch != '>')
+  // Read the markup, skipping anything that doesn't fit...
+  while ((ch = _hcFileGetc(file)) != EOF && ch != '>')
   {
     if (bufptr < bufend)
       *bufptr++ = (char)ch;
     else
-      break;
+      truncated = true;
 
     if (ch == '\'' || ch == '\"')
     {
       int quote = ch;			// Quote character
 
-      while ((ch = hcFileGetc(file)) != EOF && ch != quote)
+      while ((ch = _hcFileGetc(file)) != EOF && ch != quote)
       {
         if (bufptr < bufend)
           *bufptr++ = (char)ch;
         else
-          break;
+          truncated = true;
       }
 
-      if (ch == EOF || ch != quote || bufptr >= bufend)
+      if (ch == EOF)
         break;
-
-      *bufptr++ = (char)ch;
+      else if (bufptr < bufend)
+        *bufptr++ = (char)ch;
+      else
+        truncated = true;
     }
   }
 
@@ -639,8 +1921,336 @@ html_parse_unknown(hc_file_t  *file,	// I  - File to read from
     _hcFileError(file, "Unexpected end-of-file.");
     return (false);
   }
-  else if (ch != '>')
+  else if (truncated)
     _hcFileError(file, "Element too long.");
 
-  return (_hcNodeNewUnknown(*parent, buffer) != NULL);
+  if (html->events)
+    return (true);				// Unknown markup is not reported
+  else
+    return (_hcNodeNewUnknown(*parent, buffer) != NULL);
+}
+
+
+//
+// 'html_scan_data()' - Find the end of complete data for a HTML push parser.
+//
+// Data is complete up to the last newline in text (when text nodes are split at
+// newlines) or the end of the last complete element, comment, or directive.
+// This mirrors the way the parsing functions above read text and markup so that
+// parsing can resume at the returned offset.  Until there is a parent node,
+// only the first element is complete since parsing it determines the parent
+// node.
+//
+// Scanning resumes where the previous call stopped, so each byte of pending
+// data is only scanned once.
+//
+
+static size_t				// O - Length of complete data
+html_scan_data(
+    hc_html_parser_t *parser)		// I - HTML parser
+{
+  const _hc_uchar_t	*start = (const _hc_uchar_t *)parser->data,
+					// Start of pending data
+			*ptr = start + parser->scanpos,
+					// Pointer into data
+			*end = start + parser->datalen,
+					// End of data
+			*complete = start;
+					// End of complete data
+  bool			rooted = parser->parent != NULL,
+					// Is there a parent node?
+			lines = parser->html->split_text;
+					// Are text nodes split at newlines?
+
+
+  while (ptr < end)
+  {
+    if (parser->scanstate == _HC_HTML_SCAN_TEXT)
+    {
+      // Text may be added at each newline once there is a parent node...
+      if (*ptr == '<')
+        parser->scanstate = _HC_HTML_SCAN_LT;
+      else if (*ptr == '\n' && rooted && lines)
+        complete = ptr + 1;
+
+      ptr ++;
+    }
+    else if (parser->scanstate == _HC_HTML_SCAN_LT)
+    {
+      if (isspace(*ptr) || *ptr == '=')
+      {
+        // Unquoted '<' in text...
+        parser->scanstate = _HC_HTML_SCAN_TEXT;
+      }
+      else if (*ptr != '<')
+      {
+        // Start of markup...
+        parser->scanstate   = _HC_HTML_SCAN_NAME;
+        parser->scanclose   = *ptr == '/';
+        parser->scannamelen = 0;
+
+        if (!parser->scanclose)
+          parser->scanname[parser->scannamelen ++] = (char)*ptr;
+      }
+
+      ptr ++;
+    }
+    else if (html_scan_markup(parser, &ptr, end, rooted))
+    {
+      // Markup is complete...
+      parser->scanstate = _HC_HTML_SCAN_TEXT;
+      complete          = ptr;
+
+      if (!rooted)
+        break;				// Parent node is not known until parsed
+    }
+  }
+
+  parser->scanpos = (size_t)(ptr - start);
+
+  return ((size_t)(complete - start));
+}
+
+
+//
+// 'html_scan_markup()' - Find the end of an element, comment, or directive.
+//
+// Markup is scanned the same way it is read by the parsing functions, which
+// skip anything that doesn't fit in their buffers.  Markup that makes the
+// parsing functions stop, such as a second DOCTYPE, ends after its name.
+//
+
+static bool				// O  - `true` if complete, `false` if more data is needed
+html_scan_markup(
+    hc_html_parser_t  *parser,		// I  - HTML parser
+    const _hc_uchar_t **dataptr,	// IO - Pointer into data
+    const _hc_uchar_t *end,		// I  - End of data
+    bool              rooted)		// I  - Is there a parent node?
+{
+  const _hc_uchar_t	*ptr = *dataptr;// Pointer into data
+  int			ch;		// Current character
+  bool			complete = false,
+					// Is the markup complete?
+			term;		// Is the name followed by a delimiter?
+  hc_element_t		element;	// Element
+
+
+  while (ptr < end && !complete)
+  {
+    ch = *ptr;
+
+    switch (parser->scanstate)
+    {
+      default :
+      case _HC_HTML_SCAN_NAME :
+          // Element name, which ends at the delimiter or after "!--"...
+          if (isspace(ch) || ch == '>' || ch == '/')
+          {
+            term = true;
+          }
+          else if (parser->scannamelen >= (sizeof(parser->scanname) - 1))
+          {
+            // Long names are read as unknown markup...
+            term = false;
+          }
+          else
+          {
+            parser->scanname[parser->scannamelen ++] = (char)ch;
+            ptr ++;
+
+            if (parser->scannamelen != 3 || memcmp(parser->scanname, "!--", 3))
+              break;
+
+            term = false;
+          }
+
+          parser->scanname[parser->scannamelen] = '\0';
+          element = hcElementValue(parser->scanname);
+
+          if (element == HC_ELEMENT_DOCTYPE && !parser->scanclose && !rooted)
+          {
+            parser->scanstate = _HC_HTML_SCAN_DOCTYPE_SPACE;
+            ptr ++;
+          }
+          else if (element == HC_ELEMENT_DOCTYPE)
+          {
+            // Invalid DOCTYPE, parsing stops after the name...
+            complete = true;
+            ptr ++;
+          }
+          else if (rooted && element == HC_ELEMENT_UNKNOWN)
+          {
+            // The delimiter is read with the unknown markup...
+            parser->scanstate = _HC_HTML_SCAN_UNKNOWN;
+          }
+          else if (rooted && element == HC_ELEMENT_COMMENT)
+          {
+            parser->scanstate  = _HC_HTML_SCAN_COMMENT;
+            parser->scandashes = 0;
+          }
+          else
+          {
+            if (term)
+              ptr ++;
+
+            if (parser->scanclose || (term && ch == '>'))
+              complete = true;
+            else
+              parser->scanstate = _HC_HTML_SCAN_ATTR_SPACE;
+          }
+          break;
+
+      case _HC_HTML_SCAN_DOCTYPE_SPACE :
+          if (isspace(ch))
+            ptr ++;
+          else
+            parser->scanstate = _HC_HTML_SCAN_DOCTYPE;
+          break;
+
+      case _HC_HTML_SCAN_DOCTYPE :
+          ptr ++;
+
+          if (ch == '>')
+          {
+            complete = true;
+          }
+          else if (ch == '\'' || ch == '\"')
+          {
+            parser->scanstate = _HC_HTML_SCAN_DOCTYPE_QUOTE;
+            parser->scanquote = ch;
+          }
+          break;
+
+      case _HC_HTML_SCAN_DOCTYPE_QUOTE :
+          // Like html_parse_doctype, the closing quote is checked again as a
+          // DOCTYPE character...
+          if (ch == parser->scanquote)
+            parser->scanstate = _HC_HTML_SCAN_DOCTYPE;
+          else
+            ptr ++;
+          break;
+
+      case _HC_HTML_SCAN_UNKNOWN :
+          ptr ++;
+
+          if (ch == '>')
+          {
+            complete = true;
+          }
+          else if (ch == '\'' || ch == '\"')
+          {
+            parser->scanstate = _HC_HTML_SCAN_UNKNOWN_QUOTE;
+            parser->scanquote = ch;
+          }
+          break;
+
+      case _HC_HTML_SCAN_UNKNOWN_QUOTE :
+          ptr ++;
+
+          if (ch == parser->scanquote)
+            parser->scanstate = _HC_HTML_SCAN_UNKNOWN;
+          break;
+
+      case _HC_HTML_SCAN_COMMENT :
+          ptr ++;
+
+          if (ch == '>' && parser->scandashes >= 2)
+            complete = true;
+          else if (ch != '-')
+            parser->scandashes = 0;
+          else if (parser->scandashes < 2)
+            parser->scandashes ++;
+          break;
+
+      case _HC_HTML_SCAN_ATTR_SPACE :
+          ptr ++;
+
+          if (ch == '>')
+            complete = true;
+          else if (!isspace(ch))
+            parser->scanstate = _HC_HTML_SCAN_ATTR_NAME;
+          break;
+
+      case _HC_HTML_SCAN_ATTR_NAME :
+          ptr ++;
+
+          if (ch == '=')
+            parser->scanstate = _HC_HTML_SCAN_ATTR_VALUE;
+          else if (ch == '>')
+            complete = true;
+          else if (isspace(ch))
+            parser->scanstate = _HC_HTML_SCAN_ATTR_SPACE;
+          break;
+
+      case _HC_HTML_SCAN_ATTR_VALUE :
+          ptr ++;
+
+          if (ch == '\'' || ch == '\"')
+          {
+            parser->scanstate = _HC_HTML_SCAN_ATTR_QUOTE;
+            parser->scanquote = ch;
+          }
+          else if (ch == '>')
+          {
+            complete = true;
+          }
+          else if (isspace(ch))
+          {
+            parser->scanstate = _HC_HTML_SCAN_ATTR_SPACE;
+          }
+          else
+          {
+            parser->scanstate = _HC_HTML_SCAN_ATTR_UNQUOTED;
+          }
+          break;
+
+      case _HC_HTML_SCAN_ATTR_QUOTE :
+          ptr ++;
+
+          if (ch == parser->scanquote)
+            parser->scanstate = _HC_HTML_SCAN_ATTR_SPACE;
+          break;
+
+      case _HC_HTML_SCAN_ATTR_UNQUOTED :
+          ptr ++;
+
+          if (ch == '>')
+            complete = true;
+          else if (isspace(ch))
+            parser->scanstate = _HC_HTML_SCAN_ATTR_SPACE;
+          break;
+    }
+  }
+
+  *dataptr = ptr;
+
+  return (complete);
+}
+
+
+//
+// 'html_start_element()' - Finish adding an element.
+//
+// For event callbacks, the start callback is called with the attributes that
+// have been added using `html_add_attr`.
+//
+
+static bool				// O - `true` to continue, `false` to stop
+html_start_element(hc_html_t *html,	// I - HTML document
+                   hc_node_t *node)	// I - Element node
+{
+  size_t	num_attrs;		// Number of attributes
+
+
+  if (!html->events || !node)
+    return (true);
+
+  num_attrs             = html->num_event_attrs;
+  html->num_event_attrs = 0;
+  html->event_used      = 0;
+
+  if (html->events->start_cb && !(html->events->start_cb)(html->events_ctx, node->element, html->event_attrs, num_attrs))
+    html->event_stop = true;
+
+  return (!html->event_stop);
 }
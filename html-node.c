@@ -16,8 +16,8 @@
 // Local functions...
 //
 
-static void		html_delete(hc_node_t *node);
-static hc_node_t	*html_new(hc_node_t *parent, hc_element_t element, const char *s);
+static void		html_delete(hc_html_t *html, hc_node_t *node);
+static hc_node_t	*html_new(hc_html_t *html, hc_node_t *parent, hc_element_t element, const char *s, size_t slen);
 static void		html_remove(hc_node_t *node);
 
 
@@ -71,14 +71,14 @@ hcNodeDelete(hc_html_t *html,		// I - HTML document
     * Free child...
     */
 
-    html_delete(current);
+    html_delete(html, current);
   }
 
  /*
   * Then free the memory used by the parent node...
   */
 
-  html_delete(node);
+  html_delete(html, node);
 }
 
 
@@ -205,7 +205,7 @@ hcNodeNewComment(hc_node_t *parent,	// I - Parent node
   if (!parent || !c)
     return (NULL);
 
-  return (html_new(parent, HC_ELEMENT_COMMENT, c));
+  return (html_new(NULL, parent, HC_ELEMENT_COMMENT, c, strlen(c)));
 }
 
 
@@ -220,7 +220,7 @@ hcNodeNewElement(hc_node_t    *parent,	// I - Parent node
   if (!parent || element <= HC_ELEMENT_DOCTYPE || element >= HC_ELEMENT_MAX)
     return (NULL);
 
-  return (html_new(parent, element, NULL));
+  return (html_new(NULL, parent, element, NULL, 0));
 }
 
 
@@ -238,7 +238,7 @@ hcHTMLNewRootNode(hc_html_t  *html,	// I - HTML document
   if (!html || html->root || !doctype)
     return (NULL);
 
-  if ((node = html_new(NULL, HC_ELEMENT_DOCTYPE, NULL)) != NULL)
+  if ((node = html_new(html, NULL, HC_ELEMENT_DOCTYPE, NULL, 0)) != NULL)
   {
     html->root               = node;
     node->value.element.html = html;
@@ -261,7 +261,24 @@ hcNodeNewString(hc_node_t  *parent,	// I - Parent node
   if (!parent || !s)
     return (NULL);
 
-  return (html_new(parent, HC_ELEMENT_STRING, s));
+  return (html_new(NULL, parent, HC_ELEMENT_STRING, s, strlen(s)));
+}
+
+
+//
+// '_hcNodeNewStringLen()' - Create a new HTML string node from a string of the
+//                           specified length.
+//
+
+hc_node_t *				// O - New HTML string node
+_hcNodeNewStringLen(hc_node_t  *parent,	// I - Parent node
+                    const char *s,	// I - String value
+                    size_t     slen)	// I - Length of string value
+{
+  if (!parent || !s)
+    return (NULL);
+
+  return (html_new(NULL, parent, HC_ELEMENT_STRING, s, slen));
 }
 
 
@@ -277,7 +294,7 @@ _hcNodeNewUnknown(hc_node_t  *parent,	// I - Parent node
   if (!parent || !unk)
     return (NULL);
 
-  return (html_new(parent, HC_ELEMENT_UNKNOWN, unk));
+  return (html_new(NULL, parent, HC_ELEMENT_UNKNOWN, unk, strlen(unk)));
 }
 
 
@@ -286,12 +303,13 @@ _hcNodeNewUnknown(hc_node_t  *parent,	// I - Parent node
 //
 
 static void
-html_delete(hc_node_t *node)		// I - HTML node
+html_delete(hc_html_t *html,		// I - HTML document
+            hc_node_t *node)		// I - HTML node
 {
   if (node->element >= HC_ELEMENT_DOCTYPE)
-    hcDictDelete(node->value.element.attrs);
+    _hcDictClear(&node->value.element.attrs);
 
-  free(node);
+  _hcPoolFree(html->pool, node);
 }
 
 
@@ -300,29 +318,35 @@ html_delete(hc_node_t *node)		// I - HTML node
 //
 
 static hc_node_t *			// O - New node or `NULL` on error
-html_new(hc_node_t    *parent,		// I - Parent node or `NULL` if root node
+html_new(hc_html_t    *html,		// I - HTML document or `NULL` to use parent's
+         hc_node_t    *parent,		// I - Parent node or `NULL` if root node
          hc_element_t element,		// I - Element/node type
-         const char   *s)		// I - String, if any
+         const char   *s,		// I - String, if any
+         size_t       slen)		// I - Length of string
 {
   hc_node_t	*node;			// New node
   size_t	nodesize;		// Node size
-  size_t	slen = s ? strlen(s) : 0;
-					// Length of string
 
 
   if (parent && parent->element < HC_ELEMENT_DOCTYPE)
     return (NULL);
 
+  if (parent)
+    html = parent->value.element.html;
+
   if (element < HC_ELEMENT_DOCTYPE)
     nodesize = sizeof(hc_node_t) - sizeof(node->value) + slen + 1;
   else
     nodesize = sizeof(hc_node_t);
 
-  if ((node = (hc_node_t *)calloc(1, nodesize)) != NULL)
+  if ((node = (hc_node_t *)_hcPoolCalloc(html->pool, 1, nodesize)) != NULL)
   {
     node->element = element;
     node->parent  = parent;
 
+    if (element >= HC_ELEMENT_DOCTYPE)
+      _hcDictInit(&node->value.element.attrs, html->pool);
+
     if (s && slen > 0)
     {
       if (element == HC_ELEMENT_STRING)
@@ -13,13 +13,20 @@
 #  define HTMLCSS_HTML_PRIVATE_H
 #  include "html.h"
 #  include "common-private.h"
-#  include "dict.h"
+#  include "dict-private.h"
 #  include "pool-private.h"
 #  ifdef __cplusplus
 extern "C" {
 #  endif // __cplusplus
 
 
+//
+// Private constants...
+//
+
+#  define _HC_HTML_ATTRS	24	// Number of known attribute names
+
+
 //
 // Private types...
 //
@@ -37,7 +44,7 @@ struct _hc_node_s
     {
       hc_node_t	*first_child;		// First child node
       hc_node_t	*last_child;		// Last child node
-      hc_dict_t	*attrs;			// Attributes dictionary
+      hc_dict_t	attrs;			// Attributes dictionary
       hc_html_t	*html;			// HTML document
       const hc_dict_t *base_props;	// Base CSS properties dictionary
     }		element;		// Element value
@@ -55,6 +62,20 @@ struct _hc_html_s
   void		*error_ctx;		// Error callback context pointer
   hc_url_cb_t	url_cb;			// URL callback
   void		*url_ctx;		// URL callback context pointer
+  bool		split_text;		// Split text nodes at newlines?
+  const char	*attrs[_HC_HTML_ATTRS];	// Pooled known attribute names
+
+  const hc_html_events_t *events;	// Event callbacks or `NULL` to build a tree
+  void		*events_ctx;		// Event callback context pointer
+  hc_node_t	*event_nodes,		// All element nodes for events
+		*free_nodes;		// Unused element nodes for events
+  size_t	num_event_attrs,	// Number of attributes for current element
+		alloc_event_attrs;	// Allocated attributes
+  hc_html_attr_t *event_attrs;		// Attributes for current element
+  size_t	event_used,		// Bytes used for attribute strings
+		event_alloc;		// Allocated bytes for attribute strings
+  char		*event_data;		// Attribute strings
+  bool		event_stop;		// Stopped by an event callback?
 };
 
 
@@ -63,6 +84,7 @@ struct _hc_html_s
 //
 
 extern bool		_hcNodeComputeCSSTextFont(hc_node_t *node, const hc_dict_t *props, hc_text_t *text);
+extern hc_node_t	*_hcNodeNewStringLen(hc_node_t *parent, const char *s, size_t slen);
 extern hc_node_t	*_hcNodeNewUnknown(hc_node_t *parent, const char *unk);
 
 
@@ -164,6 +164,33 @@ typedef struct _hc_node_s hc_node_t;	// HTML node
 
 typedef struct _hc_html_s hc_html_t;	// HTML document
 
+typedef struct _hc_html_parser_s hc_html_parser_t;	// HTML push parser
+
+typedef struct hc_html_attr_s		// HTML attribute for event callbacks
+{
+  const char	*name;			// Attribute name (lowercase)
+  size_t	namelen;		// Length of name
+  const char	*value;			// Attribute value
+  size_t	valuelen;		// Length of value
+} hc_html_attr_t;
+
+typedef bool (*hc_html_comment_cb_t)(void *ctx, const char *comment, size_t commentlen);
+					// HTML comment callback
+typedef bool (*hc_html_end_cb_t)(void *ctx, hc_element_t element);
+					// HTML end element callback
+typedef bool (*hc_html_start_cb_t)(void *ctx, hc_element_t element, const hc_html_attr_t *attrs, size_t num_attrs);
+					// HTML start element callback
+typedef bool (*hc_html_text_cb_t)(void *ctx, const char *text, size_t textlen);
+					// HTML text callback
+
+typedef struct hc_html_events_s		// HTML event callbacks
+{
+  hc_html_start_cb_t	start_cb;	// Start element callback or `NULL`
+  hc_html_end_cb_t	end_cb;		// End element callback or `NULL`
+  hc_html_text_cb_t	text_cb;	// Text callback or `NULL`
+  hc_html_comment_cb_t	comment_cb;	// Comment callback or `NULL`
+} hc_html_events_t;
+
 
 //
 // Functions...
@@ -180,7 +207,12 @@ extern hc_node_t	*hcHTMLGetRootNode(hc_html_t *html) _HC_PUBLIC;
 extern bool		hcHTMLImport(hc_html_t *html, hc_file_t *file) _HC_PUBLIC;
 extern hc_html_t	*hcHTMLNew(hc_pool_t *pool, hc_css_t *css) _HC_PUBLIC;
 extern hc_node_t	*hcHTMLNewRootNode(hc_html_t *html, const char *doctype) _HC_PUBLIC;
+extern bool		hcHTMLParse(hc_file_t *file, const hc_html_events_t *events, void *ctx) _HC_PUBLIC;
+extern bool		hcHTMLParserFeed(hc_html_parser_t *parser, const void *data, size_t bytes) _HC_PUBLIC;
+extern bool		hcHTMLParserFinish(hc_html_parser_t *parser) _HC_PUBLIC;
+extern hc_html_parser_t	*hcHTMLParserNew(hc_html_t *html, const char *url) _HC_PUBLIC;
 extern void		hcHTMLSetErrorCallback(hc_html_t *html, hc_error_cb_t cb, void *cbdata) _HC_PUBLIC;
+extern void		hcHTMLSetSplitText(hc_html_t *html, bool split) _HC_PUBLIC;
 extern void		hcHTMLSetURLCallback(hc_html_t *html, hc_url_cb_t cb, void *cbdata) _HC_PUBLIC;
 
 extern size_t		hcNodeAttrGetCount(hc_node_t *node) _HC_PUBLIC;
@@ -188,6 +220,7 @@ extern const char	*hcNodeAttrGetIndexNameValue(hc_node_t *node, size_t idx, cons
 extern const char	*hcNodeAttrGetNameValue(hc_node_t *node, const char *name) _HC_PUBLIC;
 extern void		hcNodeAttrRemove(hc_node_t *node, const char *name) _HC_PUBLIC;
 extern void		hcNodeAttrSetNameValue(hc_node_t *node, const char *name, const char *value) _HC_PUBLIC;
+extern void		hcNodeAttrSetNameValueLen(hc_node_t *node, const char *name, size_t namelen, const char *value, size_t valuelen) _HC_PUBLIC;
 
 extern bool		hcNodeComputeCSSBox(hc_node_t *node, hc_compute_t compute, hc_box_t *box) _HC_PUBLIC;
 extern char		*hcNodeComputeCSSContent(hc_node_t *node, hc_compute_t compute) _HC_PUBLIC;
@@ -14,7 +14,7 @@
 //
 
 #include "image.h"
-#include "common-private.h"
+#include "pool-private.h"
 
 
 //
@@ -52,7 +52,8 @@ struct _hc_image_s
 void
 hcImageDelete(hc_image_t *image)	// I - Image object
 {
-  free(image);
+  if (image)
+    _hcPoolFree(image->pool, image);
 }
 
 
@@ -160,7 +161,7 @@ hcImageNew(hc_pool_t *pool,		// I - Memory pool
   if (!pool || !file)
     return (NULL);
 
-  if ((image = (hc_image_t *)calloc(1, sizeof(hc_image_t))) == NULL)
+  if ((image = (hc_image_t *)_hcPoolCalloc(pool, 1, sizeof(hc_image_t))) == NULL)
     return (NULL);
 
   image->pool = pool;
@@ -312,13 +313,13 @@ hcImageNew(hc_pool_t *pool,		// I - Memory pool
 
     if (image->width == 0 || image->height == 0)
     {
-      free(image);
+      _hcPoolFree(pool, image);
       return (NULL);
     }
   }
   else
   {
-    free(image);
+    _hcPoolFree(pool, image);
     return (NULL);
   }
 
@@ -28,25 +28,98 @@ extern "C" {
 typedef struct _hc_font_info_s _hc_font_info_t;
 					// Font cache information
 
+typedef struct _hc_pool_chunk_s		// String storage chunk
+{
+  struct _hc_pool_chunk_s *next;	// Next (older) chunk
+  size_t	serial,			// Serial number of chunk
+		size,			// Size of data
+		used;			// Number of bytes used
+  char		data[1];		// String data
+} _hc_pool_chunk_t;
+
+typedef struct _hc_pool_atom_s		// Atom information
+{
+  const char	*s;			// Interned string
+  unsigned	hash;			// Hash of string
+  hc_atom_t	lower;			// Atom for lowercase string
+} _hc_pool_atom_t;
+
+typedef struct _hc_pool_error_s		// Last error message for a thread
+{
+  struct _hc_pool_error_s *next;	// Next thread's error message
+  char		*message;		// Last error message or `NULL` for none
+} _hc_pool_error_t;
+
+typedef struct _hc_pool_url_s		// Cached URL lookup
+{
+  hc_atom_t	url,			// URL or `0` for an empty slot
+		baseurl;		// Base URL or `0` for none
+  const char	*mapped;		// Local file or `NULL` on error
+} _hc_pool_url_t;
+
+typedef struct _hc_pool_str_s		// Interned string
+{
+  unsigned	hash;			// Hash of string
+  hc_atom_t	atom;			// Atom for string
+  char		*s;			// String or `NULL` for an empty slot
+} _hc_pool_str_t;
+
+typedef struct _hc_pool_shard_s		// Interned string table shard
+{
+  _hc_mutex_t	mutex;			// Lock for shared pools
+  size_t	num_strings;		// Number of strings in shard
+  size_t	alloc_strings;		// Allocated size of strings hash table (power of 2)
+  _hc_pool_str_t *strings;		// Strings hash table (open addressing)
+  size_t	alloc_atoms;		// Allocated atoms
+  _hc_pool_atom_t *atoms;		// Atoms in this shard
+  size_t	intern_hits,		// Number of existing strings found
+		intern_misses;		// Number of new strings added
+  _hc_pool_chunk_t *chunks;		// String storage chunks (current first)
+  size_t	num_chunks;		// Number of chunks allocated so far
+
+  size_t	mark_strings,		// Number of strings at mark
+		mark_serial,		// First chunk serial number after mark
+		mark_used;		// Bytes used in current chunk at mark
+  _hc_pool_chunk_t *mark_chunk;		// Current chunk at mark
+} _hc_pool_shard_t;
+
 struct _hc_pool_s			// Memory pool
 {
   struct lconv	*loc;			// Locale information
   size_t	loc_declen;		// Length of decimal point
 
+  bool		shared;			// Shared between threads?
+
+  hc_alloc_cb_t	alloc_cb;		// Allocation callback or `NULL` for `malloc`
+  hc_realloc_cb_t realloc_cb;		// Reallocation callback or `NULL` for `realloc`
+  hc_free_cb_t	free_cb;		// Free callback or `NULL` for `free`
+  void		*alloc_ctx;		// Allocator callback context pointer
+
+  _hc_mutex_t	fonts_mutex;		// Lock for font cache in shared pools
   ttf_cache_t	*fonts;			// Fonts array
 
-  size_t	num_strings;		// Number of strings in pool
-  size_t	alloc_strings;		// Allocated size of strings array
-  char		**strings;		// Strings array
+  size_t	num_shards;		// Number of string table shards (power of 2)
+  _hc_pool_shard_t *shards;		// String table shards
+
+  _hc_mutex_t	urls_mutex;		// Lock for URL cache in shared pools
+  size_t	num_urls,		// Number of cached URL lookups
+		alloc_urls,		// Allocated size of URL hash table (power of 2)
+		url_hits;		// Number of URL cache hits
+  _hc_pool_url_t *urls;			// URL cache hash table (open addressing)
 
-  hc_dict_t	*urls;			// URLs mapped to local files
+  _hc_mutex_t	css_mutex;		// Lock for stylesheet list in shared pools
+  struct _hc_css_s *css;		// Stylesheets using the pool
 
   hc_error_cb_t	error_cb;		// Error callback
   void		*error_ctx;		// Error callback context pointer
   char		*last_error;		// Last error message
+  _hc_key_t	last_error_key;		// Last error message for each thread in shared pools
+  _hc_mutex_t	errors_mutex;		// Lock for thread error messages in shared pools
+  _hc_pool_error_t *errors;		// Error messages for all threads in shared pools
 
   hc_url_cb_t	url_cb;			// URL callback
   void		*url_ctx;		// URL callback context pointer
+  char		*cache_dir;		// URL cache directory or `NULL` for none
 };
 
 
@@ -54,8 +127,16 @@ struct _hc_pool_s			// Memory pool
 // Functions...
 //
 
+extern void	_hcPoolAddCSS(hc_pool_t *pool, struct _hc_css_s *css);
+extern void	*_hcPoolCalloc(hc_pool_t *pool, size_t count, size_t size);
 extern bool	_hcPoolError(hc_pool_t *pool, int linenum, const char *message, ...) _HC_FORMAT_ARGS(3, 4);
 extern bool	_hcPoolErrorv(hc_pool_t *pool, int linenum, const char *message, va_list ap);
+extern ttf_t	*_hcPoolFindFont(hc_pool_t *pool, const char *family, ttf_style_t style, ttf_weight_t weight, ttf_stretch_t stretch);
+extern void	_hcPoolFree(hc_pool_t *pool, void *ptr);
+extern void	*_hcPoolMalloc(hc_pool_t *pool, size_t size);
+extern void	*_hcPoolRealloc(hc_pool_t *pool, void *ptr, size_t size);
+extern void	_hcPoolRemoveCSS(hc_pool_t *pool, struct _hc_css_s *css);
+extern char	*_hcPoolStrdup(hc_pool_t *pool, const char *s);
 
 
 #  ifdef __cplusplus
@@ -9,15 +9,135 @@
 // information.
 //
 
-#include "pool-private.h"
+#include "css-private.h"
+#include "sha3.h"
+#include <fcntl.h>
+#include <sys/stat.h>
+
+
+//
+// Local macros...
+//
+
+#define _HC_POOL_CHUNK_SIZE	16384	// Size of string storage chunks
+#define _HC_POOL_SHARDS		16	// Number of string table shards in shared pools
 
 
 //
 // Local functions...
 //
 
-static int	compare_strings(char **a, char **b);
+static _hc_pool_shard_t *atom_shard(hc_pool_t *pool, hc_atom_t atom, size_t *idx);
+static void	cache_hex(const unsigned char *hash, char *key);
+static const char *cache_url(hc_pool_t *pool, const char *url, const char *filename, char *buffer, size_t bufsize);
+static void	clear_urls(hc_pool_t *pool);
+static char	*copy_string(hc_pool_t *pool, _hc_pool_shard_t *shard, const char *s, size_t len);
+static hc_pool_t *create_pool(const char *appname, bool shared);
+static const char *find_cached_url(hc_pool_t *pool, const char *url, char *buffer, size_t bufsize);
+static _hc_pool_str_t *find_string(hc_pool_t *pool, _hc_pool_shard_t *shard, unsigned hash, const char *s, size_t len);
+static bool	grow_strings(hc_pool_t *pool, _hc_pool_shard_t *shard);
+static bool	grow_urls(hc_pool_t *pool);
+static unsigned	hash_string(const char *s, size_t len);
+static unsigned	hash_url(hc_atom_t url, hc_atom_t baseurl);
+static hc_atom_t intern_string(hc_pool_t *pool, const char *s, size_t len, const char **str);
+static void	lock_mutex(hc_pool_t *pool, _hc_mutex_t *mutex);
+static const char *resolve_url(hc_pool_t *pool, const char *url, const char *baseurl);
 static void	ttf_error_cb(hc_pool_t *pool, const char *message);
+static void	unlock_mutex(hc_pool_t *pool, _hc_mutex_t *mutex);
+
+
+//
+// 'hcPoolAtomLower()' - Get the atom for the lowercase version of a string.
+//
+// The lowercase atom is computed when the string is first added to the pool,
+// so two atoms refer to strings that are equal when compared without regard
+// to case if their lowercase atoms are equal.
+//
+
+hc_atom_t				// O - Lowercase atom or `0` on error
+hcPoolAtomLower(hc_pool_t *pool,	// I - Memory pool
+                hc_atom_t atom)		// I - Atom
+{
+  size_t		idx;		// Index into atoms
+  _hc_pool_shard_t	*shard;		// Shard containing atom
+  hc_atom_t		lower = 0;	// Lowercase atom
+
+
+  if ((shard = atom_shard(pool, atom, &idx)) != NULL)
+  {
+    lock_mutex(pool, &shard->mutex);
+    if (idx < shard->num_strings)
+      lower = shard->atoms[idx].lower;
+    unlock_mutex(pool, &shard->mutex);
+  }
+
+  return (lower);
+}
+
+
+//
+// 'hcPoolAtomString()' - Get the string for an atom.
+//
+
+const char *				// O - String or `NULL` on error
+hcPoolAtomString(hc_pool_t *pool,	// I - Memory pool
+                 hc_atom_t atom)	// I - Atom
+{
+  size_t		idx;		// Index into atoms
+  _hc_pool_shard_t	*shard;		// Shard containing atom
+  const char		*s = NULL;	// String
+
+
+  if ((shard = atom_shard(pool, atom, &idx)) != NULL)
+  {
+    lock_mutex(pool, &shard->mutex);
+    if (idx < shard->num_strings)
+      s = shard->atoms[idx].s;
+    unlock_mutex(pool, &shard->mutex);
+  }
+
+  return (s);
+}
+
+
+//
+// '_hcPoolAddCSS()' - Add a stylesheet to the list of stylesheets using a pool.
+//
+
+void
+_hcPoolAddCSS(hc_pool_t *pool,		// I - Memory pool
+              hc_css_t  *css)		// I - Stylesheet
+{
+  lock_mutex(pool, &pool->css_mutex);
+  css->next = pool->css;
+  pool->css = css;
+  unlock_mutex(pool, &pool->css_mutex);
+}
+
+
+//
+// '_hcPoolCalloc()' - Allocate zeroed memory using the pool's allocator.
+//
+
+void *					// O - Memory or `NULL` on error
+_hcPoolCalloc(hc_pool_t *pool,		// I - Memory pool
+              size_t    count,		// I - Number of elements
+              size_t    size)		// I - Size of each element
+{
+  void	*ptr;				// Allocated memory
+
+
+  if (!pool || !pool->alloc_cb)
+    return (calloc(count, size));
+
+  if (size && count > (size_t)-1 / size)
+    return (NULL);
+
+  if ((ptr = (pool->alloc_cb)(pool->alloc_ctx, count * size)) != NULL)
+    memset(ptr, 0, count * size);
+
+  return (ptr);
+}
 
 
 //
@@ -27,22 +147,57 @@ static void	ttf_error_cb(hc_pool_t *pool, const char *message);
 void
 hcPoolDelete(hc_pool_t *pool)	// I - Memory pool
 {
+  size_t		i;		// Looping var
+  _hc_pool_shard_t	*shard;		// Current shard
+
+
   if (pool)
   {
     ttfCacheDelete(pool->fonts);
 
-    if (pool->num_strings > 0)
+    for (i = pool->num_shards, shard = pool->shards; i > 0; i --, shard ++)
     {
-      size_t	i;			// Looping var
-      char	**temp;			// String pointer
+      while (shard->chunks)
+      {
+	_hc_pool_chunk_t *next = shard->chunks->next;
+					// Next chunk
+
+	_hcPoolFree(pool, shard->chunks);
+	shard->chunks = next;
+      }
+
+      _hcPoolFree(pool, shard->strings);
+      _hcPoolFree(pool, shard->atoms);
+
+      if (pool->shared)
+        _hcMutexDestroy(&shard->mutex);
+    }
 
-      for (i = pool->num_strings, temp = pool->strings; i > 0; i --, temp ++)
-        free(*temp);
+    free(pool->shards);
+    _hcPoolFree(pool, pool->urls);
 
-      free(pool->strings);
+    if (pool->shared)
+    {
+      while (pool->errors)
+      {
+	_hc_pool_error_t *next = pool->errors->next;
+					// Next thread's error message
+
+	free(pool->errors->message);
+	free(pool->errors);
+	pool->errors = next;
+      }
+
+      _hcKeyDelete(pool->last_error_key);
+
+      _hcMutexDestroy(&pool->css_mutex);
+      _hcMutexDestroy(&pool->errors_mutex);
+      _hcMutexDestroy(&pool->fonts_mutex);
+      _hcMutexDestroy(&pool->urls_mutex);
     }
 
     free(pool->last_error);
+    free(pool->cache_dir);
     free(pool);
   }
 }
@@ -82,26 +237,181 @@ _hcPoolErrorv(
     const char *message,		// I - Printf-style message string
     va_list    ap)			// I - Pointer to additional arguments
 {
-  char		buffer[8192];		// Message buffer
+  char			buffer[8192];	// Message buffer
+  _hc_pool_error_t	*error;		// Thread's error message
 
 
   vsnprintf(buffer, sizeof(buffer), message, ap);
 
-  free(pool->last_error);
-  pool->last_error = strdup(buffer);
+  if (pool->shared)
+  {
+    // Shared pools track the last error separately for each thread.  The
+    // pool owns the messages for all threads so it can free them when it is
+    // deleted...
+    if ((error = (_hc_pool_error_t *)_hcKeyGet(pool->last_error_key)) == NULL && (error = (_hc_pool_error_t *)calloc(1, sizeof(_hc_pool_error_t))) != NULL)
+    {
+      lock_mutex(pool, &pool->errors_mutex);
+      error->next  = pool->errors;
+      pool->errors = error;
+      unlock_mutex(pool, &pool->errors_mutex);
+
+      _hcKeySet(pool->last_error_key, error);
+    }
+
+    if (error)
+    {
+      free(error->message);
+      error->message = strdup(buffer);
+    }
+  }
+  else
+  {
+    free(pool->last_error);
+    pool->last_error = strdup(buffer);
+  }
 
   return ((pool->error_cb)(pool->error_ctx, buffer, linenum));
 }
 
 
+//
+// '_hcPoolFindFont()' - Find a font in the font cache.
+//
+// The lock only covers the cache lookup.  Fonts are fully loaded by the cache
+// and are not changed afterwards, and they are only freed by `hcPoolDelete`,
+// so threads can use the returned font without holding the lock.
+//
+
+ttf_t *					// O - Font or `NULL` if not found
+_hcPoolFindFont(
+    hc_pool_t     *pool,		// I - Memory pool
+    const char    *family,		// I - Font family
+    ttf_style_t   style,		// I - Font style
+    ttf_weight_t  weight,		// I - Font weight
+    ttf_stretch_t stretch)		// I - Font stretch
+{
+  ttf_t	*font;				// Matching font
+
+
+  lock_mutex(pool, &pool->fonts_mutex);
+  font = ttfCacheFind(pool->fonts, family, style, weight, stretch);
+  unlock_mutex(pool, &pool->fonts_mutex);
+
+  return (font);
+}
+
+
+//
+// '_hcPoolFree()' - Free memory using the pool's allocator.
+//
+
+void
+_hcPoolFree(hc_pool_t *pool,		// I - Memory pool
+            void      *ptr)		// I - Memory to free or `NULL`
+{
+  if (!ptr)
+    return;
+
+  if (pool && pool->free_cb)
+    (pool->free_cb)(pool->alloc_ctx, ptr);
+  else
+    free(ptr);
+}
+
+
+//
+// 'hcPoolGetAtom()' - Find or copy a string and return its atom.
+//
+// Atoms are small integers that uniquely identify a string in the memory pool
+// and remain valid until the memory pool is deleted.
+//
+
+hc_atom_t				// O - Atom or `0` on error
+hcPoolGetAtom(hc_pool_t  *pool,		// I - Memory pool
+              const char *s)		// I - String to find/copy
+{
+  if (!pool || !s)
+    return (0);
+  else
+    return (intern_string(pool, s, strlen(s), NULL));
+}
+
+
 //
 // 'hcPoolGetLastError()' - Return the last error message recorded.
 //
+// For shared memory pools, the last error message recorded by the current
+// thread is returned.
+//
 
 const char *				// O - Last error message or `NULL`
 hcPoolGetLastError(hc_pool_t *pool)	// I - Memory pool
 {
-  return (pool ? pool->last_error : NULL);
+  if (!pool)
+    return (NULL);
+  else if (pool->shared)
+  {
+    _hc_pool_error_t *error = (_hc_pool_error_t *)_hcKeyGet(pool->last_error_key);
+					// Thread's error message
+
+    return (error ? error->message : NULL);
+  }
+  else
+    return (pool->last_error);
+}
+
+
+//
+// 'hcPoolGetStats()' - Get memory pool statistics.
+//
+// The intern and URL cache counters are cumulative and are not cleared when
+// the pool is reset.
+//
+
+bool					// O - `true` on success, `false` on error
+hcPoolGetStats(hc_pool_t       *pool,	// I - Memory pool
+               hc_pool_stats_t *stats)	// O - Statistics
+{
+  size_t		i;		// Looping var
+  _hc_pool_shard_t	*shard;		// Current shard
+  _hc_pool_chunk_t	*chunk;		// Current chunk
+
+
+  if (stats)
+    memset(stats, 0, sizeof(hc_pool_stats_t));
+
+  if (!pool || !stats)
+    return (false);
+
+  for (i = pool->num_shards, shard = pool->shards; i > 0; i --, shard ++)
+  {
+    lock_mutex(pool, &shard->mutex);
+
+    stats->num_strings   += shard->num_strings;
+    stats->table_bytes   += shard->alloc_strings * sizeof(_hc_pool_str_t) + shard->alloc_atoms * sizeof(_hc_pool_atom_t);
+    stats->intern_hits   += shard->intern_hits;
+    stats->intern_misses += shard->intern_misses;
+
+    for (chunk = shard->chunks; chunk; chunk = chunk->next)
+    {
+      stats->string_bytes  += chunk->used;
+      stats->storage_bytes += chunk->size;
+    }
+
+    unlock_mutex(pool, &shard->mutex);
+  }
+
+  lock_mutex(pool, &pool->urls_mutex);
+  stats->table_bytes += pool->alloc_urls * sizeof(_hc_pool_url_t);
+  stats->num_urls    = pool->num_urls;
+  stats->url_hits    = pool->url_hits;
+  unlock_mutex(pool, &pool->urls_mutex);
+
+  lock_mutex(pool, &pool->fonts_mutex);
+  stats->num_fonts = ttfCacheGetNumFonts(pool->fonts);
+  unlock_mutex(pool, &pool->fonts_mutex);
+
+  return (true);
 }
 
 
@@ -118,195 +428,472 @@ hcPoolGetString(
     hc_pool_t  *pool,			// I - Memory pool
     const char *s)			// I - String to find/copy
 {
-  char	*news,				// New string
-	**temp;				// Temporary string pointer
-
-
   if (!pool || !s)
     return (NULL);
-  else if (!*s)
-    return ("");
-
-  if (pool->num_strings == 1 && !strcmp(pool->strings[0], s))
-  {
-    _HC_DEBUG("hcPoolGetString: Existing string '%s' (%p) found.\n", pool->strings[0], (void *)pool->strings[0]);
-    return (pool->strings[0]);
-  }
-  else if (pool->num_strings > 1)
-  {
-    if ((temp = bsearch(&s, pool->strings, pool->num_strings, sizeof(char *), (_hc_compare_func_t)compare_strings)) != NULL)
-    {
-      _HC_DEBUG("hcPoolGetString: Existing string '%s' (%p) found.\n", *temp, (void *)*temp);
-      return (*temp);
-    }
-  }
-
-  if (pool->num_strings >= pool->alloc_strings)
-  {
-    if ((temp = realloc(pool->strings, (pool->alloc_strings + 32) * sizeof(char *))) == NULL)
-      return (NULL);
+  else
+    return (hcPoolGetStringLen(pool, s, strlen(s)));
+}
 
-    pool->alloc_strings += 32;
-    pool->strings       = temp;
-  }
 
-  temp  = pool->strings + pool->num_strings;
-  *temp = news = strdup(s);
-  pool->num_strings ++;
+//
+// 'hcPoolGetStringLen()' - Find or copy a string of the specified length.
+//
+// This function works like `hcPoolGetString` but accepts a string that
+// is not nul-terminated, for example a slice of a larger buffer.  The string
+// must not contain nul characters.
+//
 
-  if (pool->num_strings > 1)
-    qsort(pool->strings, pool->num_strings, sizeof(char *), (_hc_compare_func_t)compare_strings);
+const char *				// O - New string pointer
+hcPoolGetStringLen(
+    hc_pool_t  *pool,			// I - Memory pool
+    const char *s,			// I - String to find/copy
+    size_t     len)			// I - Length of string
+{
+  const char	*str;			// Interned string
 
-  _HC_DEBUG("hcPoolGetString: New string '%s' (%p), pool now contains %d strings.\n", news, (void *)news, (int)pool->num_strings);
 
-  return (news);
+  if (!pool || !s)
+    return (NULL);
+  else if (len == 0)
+    return ("");
+  else if (!intern_string(pool, s, len, &str))
+    return (NULL);
+  else
+    return (str);
 }
 
 
 //
 // 'hcPoolGetURL()' - Get a file corresponding to a URL.
 //
+// Results, including failures, are cached using the URL and base URL so that
+// repeated lookups do not call the URL callback again.  The cache is cleared
+// when the URL callback is changed or the pool is reset.
+//
 
 const char *				// O - Filename or `NULL` on error
 hcPoolGetURL(hc_pool_t  *pool,		// I - Memory pool
              const char *url,		// I - URL
              const char *baseurl)	// I - Base URL, if any
 {
+  hc_atom_t	url_atom,		// Atom for URL
+		base_atom = 0;		// Atom for base URL
+  size_t	idx,			// Index into hash table
+		mask;			// Hash table mask
+  _hc_pool_url_t *temp;			// Current hash table entry
   const char	*mapped;		// Mapped file
-  char		*ptr,			// Pointer into URL
-		temp[1024],		// Temporary path
-		newurl[1024];		// New URL
 
 
-  if (*url == '/')
-  {
-    if (!baseurl)
-      return (hcPoolGetString(pool, url));
-    else if (!strncmp(baseurl, "http://", 7))
-    {
-      strncpy(temp, baseurl, sizeof(temp) - 1);
-      temp[sizeof(temp) - 1] = '\0';
-      if ((ptr = strchr(temp + 7, '/')) != NULL)
-        *ptr = '\0';
+  if (!pool || !url)
+    return (NULL);
 
-      snprintf(newurl, sizeof(newurl), "%s%s", temp, url);
-      url = newurl;
-    }
-    else if (!strncmp(baseurl, "https://", 8))
-    {
-      strncpy(temp, baseurl, sizeof(temp) - 1);
-      temp[sizeof(temp) - 1] = '\0';
-      if ((ptr = strchr(temp + 8, '/')) != NULL)
-        *ptr = '\0';
+  // Look for a cached result...
+  if ((url_atom = intern_string(pool, url, strlen(url), NULL)) == 0 || (baseurl && (base_atom = intern_string(pool, baseurl, strlen(baseurl), NULL)) == 0))
+    return (NULL);
 
-      snprintf(newurl, sizeof(newurl), "%s%s", temp, url);
-      url = newurl;
-    }
-    else
-      return (hcPoolGetString(pool, url));
-  }
-  else if (strncmp(url, "http://", 7) && strncmp(url, "https://", 8))
+  lock_mutex(pool, &pool->urls_mutex);
+
+  if (pool->alloc_urls)
   {
-    if (!baseurl)
+    for (mask = pool->alloc_urls - 1, idx = hash_url(url_atom, base_atom) & mask, temp = pool->urls + idx; temp->url; idx = (idx + 1) & mask, temp = pool->urls + idx)
     {
-      getcwd(temp, sizeof(temp));
-      snprintf(newurl, sizeof(newurl), "%s/%s", temp, url);
+      if (temp->url == url_atom && temp->baseurl == base_atom)
+      {
+        pool->url_hits ++;
+        mapped = temp->mapped;
 
-      return (hcPoolGetString(pool, newurl));
+        unlock_mutex(pool, &pool->urls_mutex);
+
+        return (mapped);
+      }
     }
-    else
-    {
-      strncpy(temp, baseurl, sizeof(temp) - 1);
-      temp[sizeof(temp) - 1] = '\0';
+  }
 
-      if ((ptr = strrchr(temp, '/')) != NULL)
-        *ptr = '\0';
+  unlock_mutex(pool, &pool->urls_mutex);
 
-      snprintf(newurl, sizeof(newurl), "%s/%s", temp, url);
+  // Not cached, resolve the URL and remember the result...
+  mapped = resolve_url(pool, url, baseurl);
 
-      if (newurl[0] == '/')
-	return (hcPoolGetString(pool, newurl));
+  lock_mutex(pool, &pool->urls_mutex);
 
-      url = newurl;
+  if ((pool->num_urls + 1) * 4 <= pool->alloc_urls * 3 || grow_urls(pool))
+  {
+    // Another thread might have added the same URL while we were resolving
+    // it...
+    for (mask = pool->alloc_urls - 1, idx = hash_url(url_atom, base_atom) & mask, temp = pool->urls + idx; temp->url; idx = (idx + 1) & mask, temp = pool->urls + idx)
+    {
+      if (temp->url == url_atom && temp->baseurl == base_atom)
+        break;
     }
-  }
 
-  if ((mapped = (pool->url_cb)(pool->url_ctx, url, temp, sizeof(temp))) != NULL)
-  {
-    if (!pool->urls)
-      pool->urls = hcDictNew(pool);
+    if (!temp->url)
+    {
+      temp->url     = url_atom;
+      temp->baseurl = base_atom;
+      temp->mapped  = mapped;
 
-    hcDictSetKeyValue(pool->urls, url, temp);
-    mapped = hcPoolGetString(pool, temp);
+      pool->num_urls ++;
+    }
   }
 
+  unlock_mutex(pool, &pool->urls_mutex);
+
   return (mapped);
 }
 
 
 //
-// 'hcPoolNew()' - Create a new memory pool.
+// '_hcPoolMalloc()' - Allocate memory using the pool's allocator.
 //
 
-hc_pool_t *			// O - New memory pool
-hcPoolNew(const char *appname)	// I - Application name
+void *					// O - Memory or `NULL` on error
+_hcPoolMalloc(hc_pool_t *pool,		// I - Memory pool
+              size_t    size)		// I - Number of bytes
 {
-  hc_pool_t *pool = (hc_pool_t *)calloc(1, sizeof(hc_pool_t));
-				// New memory pool
-
-  if (pool)
-  {
-    if ((pool->loc = localeconv()) != NULL)
-    {
-      if (!pool->loc->decimal_point || !strcmp(pool->loc->decimal_point, "."))
-	pool->loc = NULL;
-      else
-	pool->loc_declen = strlen(pool->loc->decimal_point);
-    }
-
-    if ((pool->fonts = ttfCacheCreate(appname, (ttf_err_cb_t)ttf_error_cb, pool)) == NULL)
-    {
-      free(pool);
-      return (NULL);
-    }
-
-    pool->error_cb = _hcDefaultErrorCB;
-    pool->url_cb   = _hcDefaultURLCB;
-  }
-
-  return (pool);
+  if (pool && pool->alloc_cb)
+    return ((pool->alloc_cb)(pool->alloc_ctx, size));
+  else
+    return (malloc(size));
 }
 
 
 //
-// 'hcPoolSetErrorCallback()' - Set the error reporting callback.
-//
-// The default error callback writes the message to `stderr`.
+// 'hcPoolMark()' - Mark the current contents of a memory pool.
 //
-// The error callback returns 1 to continue processing or 0 to stop immediately.
+// This function records the strings currently in the memory pool so that a
+// later call to `hcPoolReset` can release everything added after the
+// mark.  Typically an application marks the pool after loading its base
+// stylesheet and then resets the pool after each document is processed.
 //
 
 void
-hcPoolSetErrorCallback(
-    hc_pool_t     *pool,		// I - Memory pool
-    hc_error_cb_t cb,			// I - Error callback or `NULL` for the default
-    void          *ctx)			// I - Context pointer for callback
+hcPoolMark(hc_pool_t *pool)		// I - Memory pool
 {
+  size_t		i;		// Looping var
+  _hc_pool_shard_t	*shard;		// Current shard
+
+
   if (!pool)
     return;
 
-  pool->error_cb  = cb ? cb : _hcDefaultErrorCB;
-  pool->error_ctx = ctx;
+  for (i = pool->num_shards, shard = pool->shards; i > 0; i --, shard ++)
+  {
+    lock_mutex(pool, &shard->mutex);
+
+    shard->mark_strings = shard->num_strings;
+    shard->mark_serial  = shard->num_chunks;
+    shard->mark_chunk   = shard->chunks;
+    shard->mark_used    = shard->chunks ? shard->chunks->used : 0;
+
+    unlock_mutex(pool, &shard->mutex);
+  }
 }
 
 
 //
-// 'hcPoolSetURLCallback()' - Set the URL callback.
+// 'hcPoolNew()' - Create a new memory pool.
 //
-// The default URL callback supports local files (only).
+
+hc_pool_t *			// O - New memory pool
+hcPoolNew(const char *appname)	// I - Application name
+{
+  return (create_pool(appname, false));
+}
+
+
 //
-// The URL callback returns a local pathname (copied to the specified buffer)
-// or `NULL` if the URL cannot be loaded/found.
+// 'hcPoolNewShared()' - Create a new memory pool that can be shared by threads.
+//
+// Shared memory pools use a lock-striped string table and serialize access to
+// the font and URL caches so that multiple threads can intern strings, load
+// fonts, and resolve URLs at the same time.  The last error message is tracked
+// separately for each thread.
+//
+// Stylesheets and HTML documents are not thread-safe - each thread must use
+// its own `hc_css_t` and `hc_html_t` objects with the shared pool.  The
+// `hcPoolMark`, `hcPoolReset`, `hcPoolSetErrorCallback`, and
+// `hcPoolSetURLCallback` functions must not be called while other threads are
+// using the pool.
+//
+// If the library was built without threading support, this function returns
+// `NULL` and sets `errno` to `ENOTSUP`.
+//
+
+hc_pool_t *			// O - New memory pool or `NULL` without threading support
+hcPoolNewShared(
+    const char *appname)	// I - Application name
+{
+#if defined(_WIN32) || defined(HAVE_PTHREAD_H)
+  return (create_pool(appname, true));
+
+#else
+  (void)appname;
+
+  errno = ENOTSUP;
+
+  return (NULL);
+#endif // _WIN32 || HAVE_PTHREAD_H
+}
+
+
+//
+// '_hcPoolRealloc()' - Reallocate memory using the pool's allocator.
+//
+
+void *					// O - New memory or `NULL` on error
+_hcPoolRealloc(hc_pool_t *pool,		// I - Memory pool
+               void      *ptr,		// I - Memory or `NULL`
+               size_t    size)		// I - New number of bytes
+{
+  if (!pool || !pool->realloc_cb)
+    return (realloc(ptr, size));
+  else if (!ptr)
+    return ((pool->alloc_cb)(pool->alloc_ctx, size));
+  else
+    return ((pool->realloc_cb)(pool->alloc_ctx, ptr, size));
+}
+
+
+//
+// '_hcPoolRemoveCSS()' - Remove a stylesheet from the list of stylesheets
+//                        using a pool.
+//
+
+void
+_hcPoolRemoveCSS(hc_pool_t *pool,	// I - Memory pool
+                 hc_css_t  *css)	// I - Stylesheet
+{
+  hc_css_t	**cssptr;		// Pointer to current stylesheet
+
+
+  lock_mutex(pool, &pool->css_mutex);
+
+  for (cssptr = &pool->css; *cssptr; cssptr = &(*cssptr)->next)
+  {
+    if (*cssptr == css)
+    {
+      *cssptr = css->next;
+      break;
+    }
+  }
+
+  unlock_mutex(pool, &pool->css_mutex);
+}
+
+
+//
+// 'hcPoolReset()' - Release strings added since the last mark.
+//
+// This function releases all strings (and their atoms) that were added to the
+// memory pool since the last call to `hcPoolMark`, or all strings if the
+// pool has not been marked.  The font cache is preserved.
+//
+// Every `hc_html_t` and `hc_css_t` object that uses the pool must be deleted
+// before calling this function, except for stylesheets that were completely
+// loaded before the mark.  The properties computed by those stylesheets are
+// discarded, so they can be used again with new documents.
+//
+
+void
+hcPoolReset(hc_pool_t *pool)		// I - Memory pool
+{
+  size_t		i, j,		// Looping vars
+			idx,		// Index into hash table
+			mask;		// Hash table mask
+  _hc_pool_shard_t	*shard;		// Current shard
+  _hc_pool_chunk_t	**chunkptr,	// Pointer to current chunk
+			*chunk;		// Current chunk
+  _hc_pool_atom_t	*atom;		// Current atom
+  _hc_pool_str_t	*temp;		// Current hash table entry
+  hc_css_t		*css;		// Current stylesheet
+
+
+  if (!pool)
+    return;
+
+  // Discard the properties computed by the remaining stylesheets...
+  lock_mutex(pool, &pool->css_mutex);
+  for (css = pool->css; css; css = css->next)
+    _hcRuleColPurge(css, &css->all_rules);
+  unlock_mutex(pool, &pool->css_mutex);
+
+  for (i = 0, shard = pool->shards; i < pool->num_shards; i ++, shard ++)
+  {
+    lock_mutex(pool, &shard->mutex);
+
+    // Free chunks allocated after the mark...
+    for (chunkptr = &shard->chunks; (chunk = *chunkptr) != NULL;)
+    {
+      if (chunk->serial >= shard->mark_serial)
+      {
+	*chunkptr = chunk->next;
+	_hcPoolFree(pool, chunk);
+      }
+      else
+	chunkptr = &chunk->next;
+    }
+
+    if (shard->mark_chunk)
+      shard->mark_chunk->used = shard->mark_used;
+
+    // Rebuild the hash table using the strings that were added before the
+    // mark...
+    if (shard->strings)
+    {
+      memset(shard->strings, 0, shard->alloc_strings * sizeof(_hc_pool_str_t));
+
+      for (j = 0, mask = shard->alloc_strings - 1, atom = shard->atoms; j < shard->mark_strings; j ++, atom ++)
+      {
+	for (idx = atom->hash & mask, temp = shard->strings + idx; temp->s; idx = (idx + 1) & mask, temp = shard->strings + idx);
+
+	temp->hash = atom->hash;
+	temp->atom = (hc_atom_t)(j * pool->num_shards + i + 1);
+	temp->s    = (char *)atom->s;
+      }
+    }
+
+    shard->num_strings = shard->mark_strings;
+
+    unlock_mutex(pool, &shard->mutex);
+  }
+
+  // Clear the URL cache...
+  clear_urls(pool);
+}
+
+
+//
+// 'hcPoolSetAllocator()' - Set the memory allocator for a pool.
+//
+// The allocator is used for all memory allocated by the library on behalf of
+// the pool, including strings, dictionaries, HTML nodes, and CSS rules.  Pass
+// `NULL` for all three callbacks to restore the default allocator (`malloc`,
+// `realloc`, and `free`).  The realloc callback is never called with a `NULL`
+// pointer.  Allocator callbacks for shared pools must be thread-safe.
+//
+// The allocator can only be changed before anything is allocated from the
+// pool, that is immediately after calling `hcPoolNew` or
+// `hcPoolNewShared`.  The pool structure itself and the font cache always
+// use the C library allocator.
+//
+
+bool					// O - `true` on success, `false` on error
+hcPoolSetAllocator(
+    hc_pool_t       *pool,		// I - Memory pool
+    hc_alloc_cb_t   alloc_cb,		// I - Allocation callback or `NULL` for the default
+    hc_realloc_cb_t realloc_cb,		// I - Reallocation callback or `NULL` for the default
+    hc_free_cb_t    free_cb,		// I - Free callback or `NULL` for the default
+    void            *ctx)		// I - Context pointer for callbacks
+{
+  size_t		i;		// Looping var
+  _hc_pool_shard_t	*shard;		// Current shard
+
+
+  if (!pool || (alloc_cb != NULL) != (realloc_cb != NULL) || (alloc_cb != NULL) != (free_cb != NULL))
+    return (false);
+
+  // Don't allow the allocator to change once memory has been allocated...
+  if (pool->urls)
+    return (false);
+
+  for (i = pool->num_shards, shard = pool->shards; i > 0; i --, shard ++)
+  {
+    if (shard->chunks || shard->strings || shard->atoms)
+      return (false);
+  }
+
+  pool->alloc_cb   = alloc_cb;
+  pool->realloc_cb = realloc_cb;
+  pool->free_cb    = free_cb;
+  pool->alloc_ctx  = ctx;
+
+  return (true);
+}
+
+
+//
+// 'hcPoolSetCacheDirectory()' - Set the directory used to cache remote URLs.
+//
+// When a cache directory is set, the local file returned by the URL callback
+// for a remote (non-"file:") URL is copied to the directory using the SHA3-256
+// digest of its content as the filename, and the URL is mapped to that file
+// using the SHA3-256 digest of the resolved URL.  Later lookups of the same
+// URL, from any pool or process using the same directory, then use the cached
+// file without calling the URL callback.  The directory is created as needed.
+//
+// Cached files are never refreshed, so the directory should be cleared when
+// the remote content changes.  Pass `NULL` to stop using a cache directory.
+//
+// This function must not be called while other threads are using the pool.
+//
+
+bool					// O - `true` on success, `false` on error
+hcPoolSetCacheDirectory(
+    hc_pool_t  *pool,			// I - Memory pool
+    const char *dir)			// I - Cache directory or `NULL` for none
+{
+  char	*newdir = NULL;			// Copy of directory
+
+
+  if (!pool)
+    return (false);
+
+  if (dir)
+  {
+    if (mkdir(dir, 0700) && errno != EEXIST)
+    {
+      _hcPoolError(pool, 0, "Unable to create cache directory '%s': %s", dir, strerror(errno));
+      return (false);
+    }
+    else if (access(dir, R_OK | W_OK))
+    {
+      _hcPoolError(pool, 0, "Unable to use cache directory '%s': %s", dir, strerror(errno));
+      return (false);
+    }
+    else if ((newdir = strdup(dir)) == NULL)
+    {
+      return (false);
+    }
+  }
+
+  free(pool->cache_dir);
+  pool->cache_dir = newdir;
+
+  clear_urls(pool);
+
+  return (true);
+}
+
+
+//
+// 'hcPoolSetErrorCallback()' - Set the error reporting callback.
+//
+// The default error callback writes the message to `stderr`.
+//
+// The error callback returns 1 to continue processing or 0 to stop immediately.
+//
+
+void
+hcPoolSetErrorCallback(
+    hc_pool_t     *pool,		// I - Memory pool
+    hc_error_cb_t cb,			// I - Error callback or `NULL` for the default
+    void          *ctx)			// I - Context pointer for callback
+{
+  if (!pool)
+    return;
+
+  pool->error_cb  = cb ? cb : _hcDefaultErrorCB;
+  pool->error_ctx = ctx;
+}
+
+
+//
+// 'hcPoolSetURLCallback()' - Set the URL callback.
+//
+// The default URL callback supports local files (only).
+//
+// The URL callback returns a local pathname (copied to the specified buffer)
+// or `NULL` if the URL cannot be loaded/found.
 //
 
 void
@@ -320,28 +907,834 @@ hcPoolSetURLCallback(
 
   pool->url_cb  = cb ? cb : _hcDefaultURLCB;
   pool->url_ctx = ctx;
+
+  clear_urls(pool);
 }
 
 
 //
-// 'compare_strings()' - Compare two strings...
+// '_hcPoolStrdup()' - Copy a string using the pool's allocator.
 //
 
-static int				// O - Result of comparison
-compare_strings(char **a,		// I - First string
-                char **b)		// I - Second string
+char *					// O - Copy of string or `NULL` on error
+_hcPoolStrdup(hc_pool_t  *pool,		// I - Memory pool
+              const char *s)		// I - String
 {
-  return (strcmp(*a, *b));
+  char		*news;			// New string
+  size_t	len = strlen(s) + 1;	// Length of string with nul
+
+
+  if ((news = _hcPoolMalloc(pool, len)) != NULL)
+    memcpy(news, s, len);
+
+  return (news);
 }
 
 
 //
-// 'ttf_error_cb()' - Relay TTF error messages to the pool.
+// 'atom_shard()' - Get the shard and index for an atom.
+//
+// Atoms are numbered so that consecutive atoms come from different shards.
+//
+
+static _hc_pool_shard_t *		// O - Shard or `NULL` on error
+atom_shard(hc_pool_t *pool,		// I - Memory pool
+           hc_atom_t atom,		// I - Atom
+           size_t    *idx)		// O - Index into shard's atoms
+{
+  if (!pool || atom == 0)
+    return (NULL);
+
+  *idx = (atom - 1) / pool->num_shards;
+
+  return (pool->shards + (atom - 1) % pool->num_shards);
+}
+
+
+//
+// 'cache_hex()' - Convert a SHA3-256 digest to a cache key string.
 //
 
 static void
-ttf_error_cb(hc_pool_t  *pool,		// I - Memory pool
-             const char *message)	// I - Error message
+cache_hex(const unsigned char *hash,	// I - SHA3-256 digest
+          char                *key)	// O - Key string (65 bytes)
 {
-  (pool->error_cb)(pool->error_ctx, message, 0);
+  size_t	i;			// Looping var
+  static const char *hexdigits = "0123456789abcdef";
+					// Hex digits
+
+
+  for (i = 0; i < HC_SHA3_256_SIZE; i ++)
+  {
+    *key++ = hexdigits[hash[i] >> 4];
+    *key++ = hexdigits[hash[i] & 15];
+  }
+
+  *key = '\0';
+}
+
+
+//
+// 'cache_url()' - Copy a URL's local file to the cache directory.
+//
+// The file is copied to a temporary file and renamed so that other pools and
+// processes never see a partial file.
+//
+
+static const char *			// O - Cached filename or `NULL` on error
+cache_url(hc_pool_t  *pool,		// I - Memory pool
+          const char *url,		// I - Resolved URL
+          const char *filename,		// I - Local file for URL
+          char       *buffer,		// I - Filename buffer
+          size_t     bufsize)		// I - Size of filename buffer
+{
+  int		infd,			// Input file
+		outfd,			// Output file
+		tries;			// Number of tries for temporary file
+  ssize_t	bytes;			// Bytes read
+  bool		ok = true;		// Copied OK?
+  hc_sha3_t	ctx;			// SHA3 hashing context
+  hc_sha3_256_t	hash;			// SHA3-256 digest
+  char		data[16384],		// Data buffer
+		urlkey[HC_SHA3_256_SIZE * 2 + 1],
+					// Key for URL
+		key[HC_SHA3_256_SIZE * 2 + 1],
+					// Key for content
+		ext[16],		// Filename extension
+		*extptr,		// Pointer into extension
+		temp[1024],		// Temporary filename
+		mapname[1024];		// URL mapping filename
+  const char	*path,			// Path in URL
+		*end,			// End of path
+		*ptr;			// Pointer into URL
+
+
+  // Get the key for the URL...
+  hcSHA3Init(&ctx);
+  hcSHA3Update(&ctx, url, strlen(url));
+  hcSHA3Final(&ctx, hash, sizeof(hash));
+  cache_hex(hash, urlkey);
+
+  // Copy the file to a temporary file, hashing the content as we go...
+  if ((infd = open(filename, O_RDONLY | O_BINARY)) < 0)
+    return (NULL);
+
+  for (tries = 0, outfd = -1; outfd < 0 && tries < 100; tries ++)
+  {
+    snprintf(temp, sizeof(temp), "%s/.%s-%d-%d", pool->cache_dir, urlkey, (int)getpid(), tries);
+    outfd = open(temp, O_WRONLY | O_CREAT | O_EXCL | O_BINARY, 0600);
+  }
+
+  if (outfd < 0)
+  {
+    close(infd);
+    return (NULL);
+  }
+
+  hcSHA3Init(&ctx);
+
+  while ((bytes = read(infd, data, sizeof(data))) > 0)
+  {
+    hcSHA3Update(&ctx, data, (size_t)bytes);
+
+    if (write(outfd, data, (size_t)bytes) != bytes)
+    {
+      ok = false;
+      break;
+    }
+  }
+
+  if (bytes < 0)
+    ok = false;
+
+  close(infd);
+
+  if (close(outfd))
+    ok = false;
+
+  if (!ok)
+  {
+    unlink(temp);
+    return (NULL);
+  }
+
+  hcSHA3Final(&ctx, hash, sizeof(hash));
+  cache_hex(hash, key);
+
+  // Keep the filename extension from the URL path, if any, for consumers that
+  // look at it.  The path starts after the scheme and host and ends at the
+  // query string or fragment...
+  ext[0] = '\0';
+
+  if ((path = strstr(url, "://")) != NULL)
+  {
+    for (path += 3; *path && *path != '/' && *path != '?' && *path != '#'; path ++);
+  }
+  else
+    path = url;
+
+  for (end = path; *end && *end != '?' && *end != '#'; end ++);
+  for (ptr = end; ptr > path && ptr[-1] != '/' && ptr[-1] != '.'; ptr --);
+
+  if (ptr > path && ptr[-1] == '.')
+  {
+    for (extptr = ext, *extptr++ = '.'; ptr < end && isalnum(*ptr & 255) && extptr < (ext + sizeof(ext) - 1); ptr ++)
+      *extptr++ = (char)tolower(*ptr);
+
+    *extptr = '\0';
+
+    if (extptr == (ext + 1))
+      ext[0] = '\0';
+  }
+
+  // Move the content into place unless another process already did so...
+  snprintf(buffer, bufsize, "%s/%s%s", pool->cache_dir, key, ext);
+
+  if (!access(buffer, R_OK))
+    unlink(temp);
+  else if (rename(temp, buffer))
+  {
+    unlink(temp);
+    return (NULL);
+  }
+
+  // Then map the URL to the content...
+  snprintf(mapname, sizeof(mapname), "%s/%s.url", pool->cache_dir, urlkey);
+  snprintf(data, sizeof(data), "%s%s", key, ext);
+
+  for (tries = 0, outfd = -1; outfd < 0 && tries < 100; tries ++)
+  {
+    snprintf(temp, sizeof(temp), "%s/.%s-%d-%d.url", pool->cache_dir, urlkey, (int)getpid(), tries);
+    outfd = open(temp, O_WRONLY | O_CREAT | O_EXCL | O_BINARY, 0600);
+  }
+
+  if (outfd >= 0)
+  {
+    bytes = (ssize_t)strlen(data);
+    ok    = write(outfd, data, (size_t)bytes) == bytes;
+
+    if (close(outfd) || !ok || rename(temp, mapname))
+      unlink(temp);
+  }
+
+  return (buffer);
+}
+
+
+//
+// 'clear_urls()' - Clear the URL cache.
+//
+
+static void
+clear_urls(hc_pool_t *pool)		// I - Memory pool
+{
+  lock_mutex(pool, &pool->urls_mutex);
+
+  if (pool->urls)
+    memset(pool->urls, 0, pool->alloc_urls * sizeof(_hc_pool_url_t));
+
+  pool->num_urls = 0;
+
+  unlock_mutex(pool, &pool->urls_mutex);
+}
+
+
+//
+// 'copy_string()' - Copy a string into a shard's string storage.
+//
+// Strings are packed into large chunks.  Strings that are too long to share a
+// chunk get a chunk of their own that is placed after the current chunk so
+// that the remaining space in the current chunk can still be used.
+//
+
+static char *				// O - Copy of string or `NULL` on error
+copy_string(hc_pool_t        *pool,	// I - Memory pool
+            _hc_pool_shard_t *shard,	// I - String table shard
+            const char       *s,	// I - String
+            size_t           len)	// I - Length of string
+{
+  char			*news;		// New string
+  _hc_pool_chunk_t	*chunk = shard->chunks;
+					// Current chunk
+
+
+  if (!chunk || (chunk->size - chunk->used) <= len)
+  {
+    // Need a new chunk...
+    _hc_pool_chunk_t	*newchunk;	// New chunk
+    bool		dedicated = len >= (_HC_POOL_CHUNK_SIZE / 4);
+					// Dedicated chunk for this string?
+    size_t		size = dedicated ? len + 1 : _HC_POOL_CHUNK_SIZE;
+					// Size of chunk data
+
+    if ((newchunk = _hcPoolMalloc(pool, sizeof(_hc_pool_chunk_t) - sizeof(newchunk->data) + size)) == NULL)
+      return (NULL);
+
+    newchunk->serial = shard->num_chunks ++;
+    newchunk->size   = size;
+    newchunk->used   = 0;
+
+    if (chunk && dedicated)
+    {
+      // Put the dedicated chunk after the current one...
+      newchunk->next = chunk->next;
+      chunk->next    = newchunk;
+    }
+    else
+    {
+      // Start using the new chunk...
+      newchunk->next = chunk;
+      shard->chunks  = newchunk;
+    }
+
+    chunk = newchunk;
+  }
+
+  news = chunk->data + chunk->used;
+  chunk->used += len + 1;
+
+  memcpy(news, s, len);
+  news[len] = '\0';
+
+  return (news);
+}
+
+
+//
+// 'create_pool()' - Create a new memory pool.
+//
+
+static hc_pool_t *			// O - New memory pool
+create_pool(const char *appname,	// I - Application name
+            bool       shared)		// I - Shared between threads?
+{
+  size_t		i;		// Looping var
+  _hc_pool_shard_t	*shard;		// Current shard
+  hc_pool_t		*pool;		// New memory pool
+
+
+  if ((pool = (hc_pool_t *)calloc(1, sizeof(hc_pool_t))) == NULL)
+    return (NULL);
+
+  if ((pool->loc = localeconv()) != NULL)
+  {
+    if (!pool->loc->decimal_point || !strcmp(pool->loc->decimal_point, "."))
+      pool->loc = NULL;
+    else
+      pool->loc_declen = strlen(pool->loc->decimal_point);
+  }
+
+  pool->num_shards = shared ? _HC_POOL_SHARDS : 1;
+  pool->error_cb   = _hcDefaultErrorCB;
+  pool->url_cb     = _hcDefaultURLCB;
+
+  if ((pool->shards = (_hc_pool_shard_t *)calloc(pool->num_shards, sizeof(_hc_pool_shard_t))) == NULL)
+  {
+    free(pool);
+    return (NULL);
+  }
+
+  if (shared)
+  {
+    if (!_hcKeyCreate(&pool->last_error_key, NULL))
+    {
+      free(pool->shards);
+      free(pool);
+      return (NULL);
+    }
+
+    pool->shared = true;
+
+    _hcMutexInit(&pool->css_mutex);
+    _hcMutexInit(&pool->errors_mutex);
+    _hcMutexInit(&pool->fonts_mutex);
+    _hcMutexInit(&pool->urls_mutex);
+
+    for (i = pool->num_shards, shard = pool->shards; i > 0; i --, shard ++)
+      _hcMutexInit(&shard->mutex);
+  }
+
+  if ((pool->fonts = ttfCacheCreate(appname, (ttf_err_cb_t)ttf_error_cb, pool)) == NULL)
+  {
+    hcPoolDelete(pool);
+    return (NULL);
+  }
+
+  return (pool);
+}
+
+
+//
+// 'find_cached_url()' - Find a URL in the cache directory.
+//
+
+static const char *			// O - Cached filename or `NULL` if not cached
+find_cached_url(hc_pool_t  *pool,	// I - Memory pool
+                const char *url,	// I - Resolved URL
+                char       *buffer,	// I - Filename buffer
+                size_t     bufsize)	// I - Size of filename buffer
+{
+  int		fd;			// URL mapping file
+  ssize_t	bytes;			// Bytes read
+  hc_sha3_t	ctx;			// SHA3 hashing context
+  hc_sha3_256_t	hash;			// SHA3-256 digest
+  char		urlkey[HC_SHA3_256_SIZE * 2 + 1],
+					// Key for URL
+		mapname[1024],		// URL mapping filename
+		name[256],		// Cached content filename
+		*ptr;			// Pointer into filename
+
+
+  // Read the content filename for the URL...
+  hcSHA3Init(&ctx);
+  hcSHA3Update(&ctx, url, strlen(url));
+  hcSHA3Final(&ctx, hash, sizeof(hash));
+  cache_hex(hash, urlkey);
+
+  snprintf(mapname, sizeof(mapname), "%s/%s.url", pool->cache_dir, urlkey);
+
+  if ((fd = open(mapname, O_RDONLY | O_BINARY)) < 0)
+    return (NULL);
+
+  bytes = read(fd, name, sizeof(name) - 1);
+  close(fd);
+
+  if (bytes <= 0)
+    return (NULL);
+
+  name[bytes] = '\0';
+
+  // Only allow hex digits and a simple extension in the filename...
+  for (ptr = name; isxdigit(*ptr & 255); ptr ++);
+
+  if ((ptr - name) != (HC_SHA3_256_SIZE * 2))
+    return (NULL);
+
+  if (*ptr == '.')
+  {
+    for (ptr ++; isalnum(*ptr & 255); ptr ++);
+  }
+
+  if (*ptr)
+    return (NULL);
+
+  snprintf(buffer, bufsize, "%s/%s", pool->cache_dir, name);
+
+  if (access(buffer, R_OK))
+    return (NULL);
+
+  return (buffer);
+}
+
+
+//
+// 'find_string()' - Find a string or the empty slot for it in a shard.
+//
+
+static _hc_pool_str_t *			// O - Matching or empty entry, `NULL` on error
+find_string(hc_pool_t        *pool,	// I - Memory pool
+            _hc_pool_shard_t *shard,	// I - String table shard
+            unsigned         hash,	// I - Hash of string
+            const char       *s,	// I - String
+            size_t           len)	// I - Length of string
+{
+  size_t	idx,			// Index into hash table
+		mask;			// Hash table mask
+  _hc_pool_str_t *temp;			// Current hash table entry
+
+
+  // Make sure the hash table has room for a new string, keeping the load factor
+  // at or below 75%...
+  if ((shard->num_strings + 1) * 4 > shard->alloc_strings * 3 && !grow_strings(pool, shard))
+    return (NULL);
+
+  // Look for an existing string using linear probing...
+  for (mask = shard->alloc_strings - 1, idx = hash & mask, temp = shard->strings + idx; temp->s; idx = (idx + 1) & mask, temp = shard->strings + idx)
+  {
+    if (temp->hash == hash && !strncmp(temp->s, s, len) && !temp->s[len])
+      break;
+  }
+
+  return (temp);
+}
+
+
+//
+// 'grow_strings()' - Double the size of a shard's strings hash table.
+//
+
+static bool				// O - `true` on success, `false` on error
+grow_strings(hc_pool_t        *pool,	// I - Memory pool
+             _hc_pool_shard_t *shard)	// I - String table shard
+{
+  size_t		i,		// Looping var
+			idx,		// Index into new hash table
+			alloc_strings,	// New size of hash table
+			mask;		// New hash table mask
+  _hc_pool_str_t	*strings,	// New hash table
+			*oldptr,	// Pointer into old hash table
+			*newptr;	// Pointer into new hash table
+
+
+  alloc_strings = shard->alloc_strings ? 2 * shard->alloc_strings : 64;
+  mask          = alloc_strings - 1;
+
+  if ((strings = _hcPoolCalloc(pool, alloc_strings, sizeof(_hc_pool_str_t))) == NULL)
+    return (false);
+
+  // Rehash the existing strings using the stored hash values...
+  for (i = shard->alloc_strings, oldptr = shard->strings; i > 0; i --, oldptr ++)
+  {
+    if (!oldptr->s)
+      continue;
+
+    for (idx = oldptr->hash & mask, newptr = strings + idx; newptr->s; idx = (idx + 1) & mask, newptr = strings + idx);
+
+    *newptr = *oldptr;
+  }
+
+  _hcPoolFree(pool, shard->strings);
+
+  shard->alloc_strings = alloc_strings;
+  shard->strings       = strings;
+
+  return (true);
+}
+
+
+//
+// 'grow_urls()' - Grow the URL cache hash table.
+//
+
+static bool				// O - `true` on success, `false` on error
+grow_urls(hc_pool_t *pool)		// I - Memory pool
+{
+  size_t		i,		// Looping var
+			idx,		// Index into new hash table
+			alloc_urls,	// New size of hash table
+			mask;		// New hash table mask
+  _hc_pool_url_t	*urls,		// New hash table
+			*oldptr,	// Pointer into old hash table
+			*newptr;	// Pointer into new hash table
+
+
+  alloc_urls = pool->alloc_urls ? 2 * pool->alloc_urls : 64;
+  mask       = alloc_urls - 1;
+
+  if ((urls = _hcPoolCalloc(pool, alloc_urls, sizeof(_hc_pool_url_t))) == NULL)
+    return (false);
+
+  for (i = pool->alloc_urls, oldptr = pool->urls; i > 0; i --, oldptr ++)
+  {
+    if (!oldptr->url)
+      continue;
+
+    for (idx = hash_url(oldptr->url, oldptr->baseurl) & mask, newptr = urls + idx; newptr->url; idx = (idx + 1) & mask, newptr = urls + idx);
+
+    *newptr = *oldptr;
+  }
+
+  _hcPoolFree(pool, pool->urls);
+
+  pool->alloc_urls = alloc_urls;
+  pool->urls       = urls;
+
+  return (true);
+}
+
+
+//
+// 'hash_string()' - Compute the FNV-1a hash of a string.
+//
+
+static unsigned				// O - Hash value
+hash_string(const char *s,		// I - String
+            size_t     len)		// I - Length of string
+{
+  unsigned	hash = 2166136261U;	// Hash value
+
+
+  while (len > 0)
+  {
+    hash ^= (_hc_uchar_t)*s++;
+    hash *= 16777619U;
+    len --;
+  }
+
+  return (hash);
+}
+
+
+//
+// 'hash_url()' - Compute the hash for a URL and base URL.
+//
+
+static unsigned				// O - Hash value
+hash_url(hc_atom_t url,			// I - URL atom
+         hc_atom_t baseurl)		// I - Base URL atom or `0`
+{
+  return ((url * 31U + baseurl) * 2654435761U);
+}
+
+
+//
+// 'intern_string()' - Find or copy a string, returning its atom.
+//
+// The upper bits of the string's hash select the shard, and the lower bits
+// select the entry in the shard's hash table.
+//
+
+static hc_atom_t			// O - Atom or `0` on error
+intern_string(hc_pool_t  *pool,		// I - Memory pool
+              const char *s,		// I - String to find/copy
+              size_t     len,		// I - Length of string
+              const char **str)		// O - Interned string or `NULL`
+{
+  size_t		i,		// Looping var
+			idx;		// Index into atoms
+  unsigned		hash;		// Hash of string
+  hc_atom_t		atom,		// Atom
+			lower = 0;	// Lowercase atom
+  _hc_pool_shard_t	*shard;		// Shard for string
+  _hc_pool_str_t	*temp;		// Current hash table entry
+  char			*news;		// New string
+
+
+  hash  = hash_string(s, len);
+  shard = pool->shards + ((hash >> 24) & (pool->num_shards - 1));
+
+  lock_mutex(pool, &shard->mutex);
+
+  if ((temp = find_string(pool, shard, hash, s, len)) != NULL && !temp->s)
+  {
+    // Not found, add the lowercase version of the string first as needed...
+    for (i = 0; i < len; i ++)
+    {
+      if (isupper(s[i] & 255))
+        break;
+    }
+
+    if (i < len)
+    {
+      char	buffer[256],		// Lowercase string buffer
+		*lowers;		// Lowercase string
+
+      unlock_mutex(pool, &shard->mutex);
+
+      if (len < sizeof(buffer))
+	lowers = buffer;
+      else
+	lowers = _hcPoolMalloc(pool, len);
+
+      if (lowers)
+      {
+	for (i = 0; i < len; i ++)
+	  lowers[i] = (char)tolower(s[i] & 255);
+
+	lower = intern_string(pool, lowers, len, NULL);
+
+	if (lowers != buffer)
+	  _hcPoolFree(pool, lowers);
+      }
+
+      // Look again since another thread may have added the string...
+      lock_mutex(pool, &shard->mutex);
+
+      temp = find_string(pool, shard, hash, s, len);
+    }
+  }
+
+  if (!temp)
+  {
+    unlock_mutex(pool, &shard->mutex);
+    return (0);
+  }
+  else if (temp->s)
+  {
+    _HC_DEBUG("intern_string: Existing string '%s' (%p) found.\n", temp->s, (void *)temp->s);
+
+    shard->intern_hits ++;
+    atom = temp->atom;
+
+    if (str)
+      *str = temp->s;
+
+    unlock_mutex(pool, &shard->mutex);
+
+    return (atom);
+  }
+
+  // Add a copy to the empty slot...
+  if (shard->num_strings >= shard->alloc_atoms)
+  {
+    _hc_pool_atom_t	*atoms;		// New atoms array
+    size_t		alloc_atoms = shard->alloc_atoms ? 2 * shard->alloc_atoms : 64;
+					// New size of atoms array
+
+    if ((atoms = _hcPoolRealloc(pool, shard->atoms, alloc_atoms * sizeof(_hc_pool_atom_t))) == NULL)
+    {
+      unlock_mutex(pool, &shard->mutex);
+      return (0);
+    }
+
+    shard->alloc_atoms = alloc_atoms;
+    shard->atoms       = atoms;
+  }
+
+  if ((news = copy_string(pool, shard, s, len)) == NULL)
+  {
+    unlock_mutex(pool, &shard->mutex);
+    return (0);
+  }
+
+  idx  = shard->num_strings;
+  atom = (hc_atom_t)(idx * pool->num_shards + (size_t)(shard - pool->shards) + 1);
+
+  temp->hash = hash;
+  temp->atom = atom;
+  temp->s    = news;
+
+  shard->atoms[idx].s     = news;
+  shard->atoms[idx].hash  = hash;
+  shard->atoms[idx].lower = lower ? lower : atom;
+  shard->num_strings ++;
+  shard->intern_misses ++;
+
+  _HC_DEBUG("intern_string: New string '%s' (%p), shard now contains %d strings.\n", news, (void *)news, (int)shard->num_strings);
+
+  if (str)
+    *str = news;
+
+  unlock_mutex(pool, &shard->mutex);
+
+  return (atom);
+}
+
+
+//
+// 'lock_mutex()' - Lock a mutex in a shared pool.
+//
+
+static void
+lock_mutex(hc_pool_t   *pool,		// I - Memory pool
+           _hc_mutex_t *mutex)		// I - Mutex
+{
+  if (pool->shared)
+    _hcMutexLock(mutex);
+}
+
+
+//
+// 'resolve_url()' - Map a URL to a local file.
+//
+
+static const char *			// O - Filename or `NULL` on error
+resolve_url(hc_pool_t  *pool,		// I - Memory pool
+            const char *url,		// I - URL
+            const char *baseurl)	// I - Base URL, if any
+{
+  char		*ptr,			// Pointer into URL
+		temp[1024],		// Temporary path
+		newurl[1024];		// New URL
+
+
+  if (*url == '/')
+  {
+    if (!baseurl)
+      return (hcPoolGetString(pool, url));
+    else if (!strncmp(baseurl, "http://", 7))
+    {
+      strncpy(temp, baseurl, sizeof(temp) - 1);
+      temp[sizeof(temp) - 1] = '\0';
+      if ((ptr = strchr(temp + 7, '/')) != NULL)
+        *ptr = '\0';
+
+      snprintf(newurl, sizeof(newurl), "%s%s", temp, url);
+      url = newurl;
+    }
+    else if (!strncmp(baseurl, "https://", 8))
+    {
+      strncpy(temp, baseurl, sizeof(temp) - 1);
+      temp[sizeof(temp) - 1] = '\0';
+      if ((ptr = strchr(temp + 8, '/')) != NULL)
+        *ptr = '\0';
+
+      snprintf(newurl, sizeof(newurl), "%s%s", temp, url);
+      url = newurl;
+    }
+    else
+      return (hcPoolGetString(pool, url));
+  }
+  else if (strncmp(url, "http://", 7) && strncmp(url, "https://", 8))
+  {
+    if (!baseurl)
+    {
+      getcwd(temp, sizeof(temp));
+      snprintf(newurl, sizeof(newurl), "%s/%s", temp, url);
+
+      return (hcPoolGetString(pool, newurl));
+    }
+    else
+    {
+      strncpy(temp, baseurl, sizeof(temp) - 1);
+      temp[sizeof(temp) - 1] = '\0';
+
+      if ((ptr = strrchr(temp, '/')) != NULL)
+        *ptr = '\0';
+
+      snprintf(newurl, sizeof(newurl), "%s/%s", temp, url);
+
+      if (newurl[0] == '/')
+	return (hcPoolGetString(pool, newurl));
+
+      url = newurl;
+    }
+  }
+
+  // Use the cache directory for remote URLs, if any...
+  if (pool->cache_dir && strstr(url, "://") && strncmp(url, "file://", 7))
+  {
+    char	cached[1024];		// Cached filename
+
+    if (find_cached_url(pool, url, cached, sizeof(cached)))
+      return (hcPoolGetString(pool, cached));
+
+    if (!(pool->url_cb)(pool->url_ctx, url, temp, sizeof(temp)))
+      return (NULL);
+
+    if (cache_url(pool, url, temp, cached, sizeof(cached)))
+      return (hcPoolGetString(pool, cached));
+    else
+      return (hcPoolGetString(pool, temp));
+  }
+
+  if ((pool->url_cb)(pool->url_ctx, url, temp, sizeof(temp)))
+    return (hcPoolGetString(pool, temp));
+  else
+    return (NULL);
+}
+
+
+//
+// 'ttf_error_cb()' - Relay TTF error messages to the pool.
+//
+
+static void
+ttf_error_cb(hc_pool_t  *pool,		// I - Memory pool
+             const char *message)	// I - Error message
+{
+  (pool->error_cb)(pool->error_ctx, message, 0);
+}
+
+
+//
+// 'unlock_mutex()' - Unlock a mutex in a shared pool.
+//
+
+static void
+unlock_mutex(hc_pool_t   *pool,		// I - Memory pool
+             _hc_mutex_t *mutex)	// I - Mutex
+{
+  if (pool->shared)
+    _hcMutexUnlock(mutex);
 }
@@ -3,7 +3,7 @@
 //
 //     https://github.com/michaelrsweet/htmlcss
 //
-// Copyright © 2018-2025 by Michael R Sweet.
+// Copyright © 2018-2026 by Michael R Sweet.
 //
 // Licensed under Apache License v2.0.  See the file "LICENSE" for more
 // information.
@@ -23,7 +23,25 @@ extern "C" {
 
 typedef struct _hc_pool_s hc_pool_t;	// Memory allocation pool
 
+typedef unsigned hc_atom_t;		// Interned string identifier (0 = none)
+
+typedef struct hc_pool_stats_s		// Memory pool statistics
+{
+  size_t		num_strings;	// Number of interned strings
+  size_t		string_bytes;	// Bytes used by interned strings
+  size_t		storage_bytes;	// Bytes allocated for string storage
+  size_t		table_bytes;	// Bytes allocated for hash tables
+  size_t		intern_hits;	// Number of lookups that found an existing string
+  size_t		intern_misses;	// Number of lookups that added a new string
+  size_t		num_urls;	// Number of cached URL lookups
+  size_t		url_hits;	// Number of URL cache hits
+  size_t		num_fonts;	// Number of fonts in the font cache
+} hc_pool_stats_t;
+
+typedef void *(*hc_alloc_cb_t)(void *ctx, size_t size);
 typedef bool (*hc_error_cb_t)(void *ctx, const char *message, int linenum);
+typedef void (*hc_free_cb_t)(void *ctx, void *ptr);
+typedef void *(*hc_realloc_cb_t)(void *ctx, void *ptr, size_t size);
 typedef char *(*hc_url_cb_t)(void *ctx, const char *url, char *buffer, size_t bufsize);
 
 
@@ -31,11 +49,21 @@ typedef char *(*hc_url_cb_t)(void *ctx, const char *url, char *buffer, size_t bu
 // Functions...
 //
 
+extern hc_atom_t	hcPoolAtomLower(hc_pool_t *pool, hc_atom_t atom);
+extern const char	*hcPoolAtomString(hc_pool_t *pool, hc_atom_t atom);
 extern void		hcPoolDelete(hc_pool_t *pool);
+extern hc_atom_t	hcPoolGetAtom(hc_pool_t *pool, const char *s);
 extern const char	*hcPoolGetLastError(hc_pool_t *pool);
+extern bool		hcPoolGetStats(hc_pool_t *pool, hc_pool_stats_t *stats);
 extern const char	*hcPoolGetString(hc_pool_t *pool, const char *s);
+extern const char	*hcPoolGetStringLen(hc_pool_t *pool, const char *s, size_t len);
 extern const char	*hcPoolGetURL(hc_pool_t *pool, const char *url, const char *baseurl);
+extern void		hcPoolMark(hc_pool_t *pool);
 extern hc_pool_t	*hcPoolNew(const char *appname);
+extern hc_pool_t	*hcPoolNewShared(const char *appname);
+extern void		hcPoolReset(hc_pool_t *pool);
+extern bool		hcPoolSetAllocator(hc_pool_t *pool, hc_alloc_cb_t alloc_cb, hc_realloc_cb_t realloc_cb, hc_free_cb_t free_cb, void *ctx);
+extern bool		hcPoolSetCacheDirectory(hc_pool_t *pool, const char *dir);
 extern void		hcPoolSetErrorCallback(hc_pool_t *pool, hc_error_cb_t cb, void *ctx);
 extern void		hcPoolSetURLCallback(hc_pool_t *pool, hc_url_cb_t cb, void *ctx);
 
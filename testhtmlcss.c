@@ -15,17 +15,74 @@
 
 #include "htmlcss.h"
 #include "css-private.h"
+#include "file-private.h"
 #include "image.h"
 #include "sha3.h"
+#include <dirent.h>
+#ifdef HAVE_PTHREAD_H
+#  include <pthread.h>
+#endif // HAVE_PTHREAD_H
+
+
+//
+// Local types...
+//
+
+typedef struct alloc_test_s		// Allocator test data
+{
+  size_t	allocs,			// Number of allocations
+		reallocs,		// Number of reallocations
+		frees;			// Number of frees
+} alloc_test_t;
+
+typedef struct event_test_s		// HTML event test data
+{
+  char		log[1024];		// Event log
+  size_t	count,			// Number of events
+		stop;			// Event to stop at or `0` for none
+} event_test_t;
+
+typedef struct shared_test_s		// Shared pool test data
+{
+  hc_pool_t	*pool;			// Memory pool
+  bool		reverse;		// Add strings in reverse order?
+  const char	*strings[1000];		// Strings from memory pool
+  hc_atom_t	atoms[1000];		// Atoms for strings
+  const char	*last_error;		// Last error message for thread
+} shared_test_t;
 
 
 //
 // Local functions...
 //
 
+static void	*alloc_cb(alloc_test_t *data, size_t size);
+static bool	compare_nodes(hc_node_t *a, hc_node_t *b);
 static bool	error_cb(void *ctx, const char *message, int linenum);
+static bool	event_comment_cb(event_test_t *data, const char *comment, size_t commentlen);
+static bool	event_end_cb(event_test_t *data, hc_element_t element);
+static bool	event_start_cb(event_test_t *data, hc_element_t element, const hc_html_attr_t *attrs, size_t num_attrs);
+static bool	event_text_cb(event_test_t *data, const char *text, size_t textlen);
+static void	free_cb(alloc_test_t *data, void *ptr);
+static void	*realloc_cb(alloc_test_t *data, void *ptr, size_t size);
+#ifdef HAVE_PTHREAD_H
+static void	*shared_pool_thread(shared_test_t *data);
+#endif // HAVE_PTHREAD_H
+static int	test_allocator_functions(void);
+static int	test_cache_functions(void);
+static int	test_charref_functions(hc_pool_t *pool);
+static int	test_compute_functions(hc_pool_t *pool);
+static int	test_dict_functions(hc_pool_t *pool);
+static int	test_element_functions(void);
+static int	test_event_functions(hc_pool_t *pool);
+static int	test_file_functions(hc_pool_t *pool);
+static int	test_parser_functions(hc_pool_t *pool);
 static int	test_pool_functions(hc_pool_t *pool);
+#ifdef HAVE_PTHREAD_H
+static int	test_shared_pool_functions(void);
+#endif // HAVE_PTHREAD_H
 static int	test_sha3_functions(void);
+static char	*url_cb(void *ctx, const char *url, char *buffer, size_t bufsize);
 
 
 //
@@ -165,9 +222,49 @@ main(int  argc,				// I - Number of command-line arguments
     if (!test_sha3_functions())
       return (1);
 
+    // Test CSS computation functions...
+    if (!test_compute_functions(pool))
+      return (1);
+
+    // Test dictionary functions...
+    if (!test_dict_functions(pool))
+      return (1);
+
+    // Test element functions...
+    if (!test_element_functions())
+      return (1);
+
+    // Test HTML event functions...
+    if (!test_event_functions(pool))
+      return (1);
+
+    // Test file functions...
+    if (!test_file_functions(pool))
+      return (1);
+
+    // Test HTML push parser functions...
+    if (!test_parser_functions(pool))
+      return (1);
+
+    // Test HTML character reference functions...
+    if (!test_charref_functions(pool))
+      return (1);
+
     // Test string pool functions...
     if (!test_pool_functions(pool))
       return (1);
+
+#ifdef HAVE_PTHREAD_H
+    if (!test_shared_pool_functions())
+      return (1);
+#endif // HAVE_PTHREAD_H
+
+    if (!test_allocator_functions())
+      return (1);
+
+    // Test URL cache directory functions...
+    if (!test_cache_functions())
+      return (1);
   }
 
   if (show_html)
@@ -300,112 +397,1461 @@ main(int  argc,				// I - Number of command-line arguments
 	      break;
 	}
 
-	if (sel->element == HC_ELEMENT_WILDCARD)
-	  fputs("*", stdout);
-	else
-	  fputs(hcElementString(sel->element), stdout);
+	if (sel->element == HC_ELEMENT_WILDCARD)
+	  fputs("*", stdout);
+	else
+	  fputs(hcElementString(sel->element), stdout);
+
+	for (j = 0, stmt = sel->stmts; j < (int)sel->num_stmts; j ++, stmt ++)
+	{
+	  switch (stmt->match)
+	  {
+	    case _HC_MATCH_ATTR_EXIST :
+		printf("[%s]", stmt->name);
+		break;
+	    case _HC_MATCH_ATTR_EQUALS :
+		printf("[%s=\"%s\"]", stmt->name, stmt->value);
+		break;
+	    case _HC_MATCH_ATTR_CONTAINS :
+		printf("[%s*=\"%s\"]", stmt->name, stmt->value);
+		break;
+	    case _HC_MATCH_ATTR_BEGINS :
+		printf("[%s^=\"%s\"]", stmt->name, stmt->value);
+		break;
+	    case _HC_MATCH_ATTR_ENDS :
+		printf("[%s$=\"%s\"]", stmt->name, stmt->value);
+		break;
+	    case _HC_MATCH_ATTR_LANG :
+		printf("[%s|=\"%s\"]", stmt->name, stmt->value);
+		break;
+	    case _HC_MATCH_ATTR_SPACE :
+		printf("[%s~=\"%s\"]", stmt->name, stmt->value);
+		break;
+	    case _HC_MATCH_CLASS :
+		printf(".%s", stmt->name);
+		break;
+	    case _HC_MATCH_ID :
+		printf("#%s", stmt->name);
+		break;
+	    case _HC_MATCH_PSEUDO_CLASS :
+		if (stmt->value)
+		  printf(":%s(%s)", stmt->name, stmt->value);
+		else
+		  printf(":%s", stmt->name);
+		break;
+	  }
+	}
+
+	putchar(' ');
+      }
+
+      putchar('<');
+      for (j = 0; j < HC_SHA3_256_SIZE; j ++)
+	printf("%02X", rule->hash[j]);
+      putchar('>');
+      putchar(' ');
+      puts("{");
+
+      for (pindex = 0, pcount = hcDictGetCount(rule->props); pindex < pcount; pindex ++)
+      {
+	pvalue = hcDictGetIndexKeyValue(rule->props, pindex, &pname);
+	printf("  %s: %s;\n", pname, pvalue);
+      }
+
+      puts("}");
+    }
+  }
+
+  if (show_font_cache)
+  {
+    size_t	findex,			// Font index
+		num_fonts;		// Number of cached fonts
+    ttf_t	*font;			// Cached font
+
+    printf("\nCached Fonts (%lu):\n", (unsigned long)ttfCacheGetNumFonts(pool->fonts));
+
+    for (findex = 0, num_fonts = ttfCacheGetNumFonts(pool->fonts); findex < num_fonts; findex ++)
+    {
+      if ((font = ttfCacheGetFont(pool->fonts, findex)) != NULL)
+      {
+        ttf_style_t style = ttfGetStyle(font);
+
+        printf("  \"%s\" (%s) %s %d\n", ttfGetFamily(font), ttfGetPostScriptName(font), style == TTF_STYLE_NORMAL ? "normal" : style == TTF_STYLE_ITALIC ? "italic" : "oblique", ttfGetWeight(font));
+      }
+    }
+  }
+
+  hcHTMLDelete(html);
+  hcCSSDelete(css);
+  hcPoolDelete(pool);
+
+  return (0);
+}
+
+
+//
+// 'alloc_cb()' - Allocate memory and count allocations.
+//
+
+static void *				// O - Memory or `NULL` on error
+alloc_cb(alloc_test_t *data,		// I - Allocator test data
+         size_t       size)		// I - Number of bytes
+{
+  data->allocs ++;
+
+  return (malloc(size));
+}
+
+
+//
+// 'compare_nodes()' - Compare two HTML node trees.
+//
+
+static bool				// O - `true` if the same, `false` otherwise
+compare_nodes(hc_node_t *a,		// I - First node
+              hc_node_t *b)		// I - Second node
+{
+  size_t	i,			// Looping var
+		count;			// Number of attributes
+  const char	*aname,			// First attribute name
+		*bname,			// Second attribute name
+		*avalue,		// First attribute value
+		*bvalue;		// Second attribute value
+
+
+  for (; a && b; a = hcNodeGetNextSiblingNode(a), b = hcNodeGetNextSiblingNode(b))
+  {
+    if (hcNodeGetElement(a) != hcNodeGetElement(b))
+      return (false);
+
+    switch (hcNodeGetElement(a))
+    {
+      case HC_ELEMENT_STRING :
+          if (strcmp(hcNodeGetString(a), hcNodeGetString(b)))
+            return (false);
+          break;
+
+      case HC_ELEMENT_COMMENT :
+          if (strcmp(hcNodeGetComment(a), hcNodeGetComment(b)))
+            return (false);
+          break;
+
+      case HC_ELEMENT_UNKNOWN :
+          break;
+
+      default :
+          if ((count = hcNodeAttrGetCount(a)) != hcNodeAttrGetCount(b))
+            return (false);
+
+          for (i = 0; i < count; i ++)
+          {
+            avalue = hcNodeAttrGetIndexNameValue(a, i, &aname);
+            bvalue = hcNodeAttrGetIndexNameValue(b, i, &bname);
+
+            if (strcmp(aname, bname) || strcmp(avalue, bvalue))
+              return (false);
+          }
+
+          if (!compare_nodes(hcNodeGetFirstChildNode(a), hcNodeGetFirstChildNode(b)))
+            return (false);
+          break;
+    }
+  }
+
+  return (!a && !b);
+}
+
+
+//
+// 'error_cb()' - Error callback for HTMLCSS...
+//
+
+static bool				// O - `true` to continue
+error_cb(void       *ctx,		// I - User data (not used)
+         const char *message,		// I - Message string (not used)
+         int        linenum)		// I - Line number (not used)
+{
+  (void)ctx;
+  (void)message;
+  (void)linenum;
+
+  return (true);
+}
+
+
+//
+// 'event_comment_cb()' - Log a comment event.
+//
+
+static bool				// O - `true` to continue, `false` to stop
+event_comment_cb(
+    event_test_t *data,			// I - Event test data
+    const char   *comment,		// I - Comment string
+    size_t       commentlen)		// I - Length of comment
+{
+  size_t	len = strlen(data->log);// Length of log
+
+
+  snprintf(data->log + len, sizeof(data->log) - len, "{%.*s}", (int)commentlen, comment);
+
+  return (++ data->count != data->stop);
+}
+
+
+//
+// 'event_end_cb()' - Log an end element event.
+//
+
+static bool				// O - `true` to continue, `false` to stop
+event_end_cb(event_test_t *data,	// I - Event test data
+             hc_element_t element)	// I - Element
+{
+  size_t	len = strlen(data->log);// Length of log
+
+
+  snprintf(data->log + len, sizeof(data->log) - len, "</%s>", hcElementString(element));
+
+  return (++ data->count != data->stop);
+}
+
+
+//
+// 'event_start_cb()' - Log a start element event.
+//
+
+static bool				// O - `true` to continue, `false` to stop
+event_start_cb(
+    event_test_t         *data,		// I - Event test data
+    hc_element_t         element,	// I - Element
+    const hc_html_attr_t *attrs,	// I - Attributes
+    size_t               num_attrs)	// I - Number of attributes
+{
+  size_t	i,			// Looping var
+		len = strlen(data->log);// Length of log
+
+
+  snprintf(data->log + len, sizeof(data->log) - len, "<%s", hcElementString(element));
+
+  for (i = 0; i < num_attrs; i ++)
+  {
+    len = strlen(data->log);
+    snprintf(data->log + len, sizeof(data->log) - len, " %s=%s", attrs[i].name, attrs[i].value);
+  }
+
+  len = strlen(data->log);
+  snprintf(data->log + len, sizeof(data->log) - len, ">");
+
+  return (++ data->count != data->stop);
+}
+
+
+//
+// 'event_text_cb()' - Log a text event.
+//
+
+static bool				// O - `true` to continue, `false` to stop
+event_text_cb(event_test_t *data,	// I - Event test data
+              const char   *text,	// I - Text string
+              size_t       textlen)	// I - Length of text
+{
+  size_t	len = strlen(data->log);// Length of log
+
+
+  snprintf(data->log + len, sizeof(data->log) - len, "[%.*s]", (int)textlen, text);
+
+  return (++ data->count != data->stop);
+}
+
+
+//
+// 'free_cb()' - Free memory and count frees.
+//
+
+static void
+free_cb(alloc_test_t *data,		// I - Allocator test data
+        void         *ptr)		// I - Memory to free
+{
+  data->frees ++;
+
+  free(ptr);
+}
+
+
+//
+// 'realloc_cb()' - Reallocate memory and count reallocations.
+//
+
+static void *				// O - New memory or `NULL` on error
+realloc_cb(alloc_test_t *data,		// I - Allocator test data
+           void         *ptr,		// I - Memory to reallocate
+           size_t       size)		// I - New number of bytes
+{
+  data->reallocs ++;
+
+  return (realloc(ptr, size));
+}
+
+
+#ifdef HAVE_PTHREAD_H
+//
+// 'shared_pool_thread()' - Add strings to a shared memory pool.
+//
+
+static void *				// O - Thread exit status (unused)
+shared_pool_thread(shared_test_t *data)	// I - Test data
+{
+  int	i;				// Looping var
+  char	s[32];				// String
+
+
+  for (i = 0; i < 1000; i ++)
+  {
+    int j = data->reverse ? 999 - i : i;// String number
+
+    snprintf(s, sizeof(s), "Shared-%d", j);
+    data->strings[j] = hcPoolGetString(data->pool, s);
+    data->atoms[j]   = hcPoolGetAtom(data->pool, s);
+  }
+
+  // Record an error message for this thread...
+  _hcPoolError(data->pool, 0, "Thread error %p.", (void *)data);
+  data->last_error = hcPoolGetLastError(data->pool);
+
+  return (NULL);
+}
+#endif // HAVE_PTHREAD_H
+
+
+//
+// 'test_allocator_functions()' - Test custom memory allocators.
+//
+
+static int				// O - 1 on success, 0 on failure
+test_allocator_functions(void)
+{
+  hc_pool_t	*pool;			// Memory pool
+  hc_css_t	*css;			// Stylesheet
+  hc_html_t	*html;			// HTML document
+  hc_file_t	*file;			// HTML file
+  hc_node_t	*node,			// Current node
+		*next;			// Next node
+  alloc_test_t	data;			// Allocator test data
+
+
+  puts("Testing custom memory allocator:\n");
+
+  memset(&data, 0, sizeof(data));
+
+  if ((pool = hcPoolNew("testhtmlcss")) == NULL)
+  {
+    puts("FAILED creating memory pool.");
+    return (0);
+  }
+
+  hcPoolSetErrorCallback(pool, error_cb, NULL);
+
+  if (!hcPoolSetAllocator(pool, (hc_alloc_cb_t)alloc_cb, (hc_realloc_cb_t)realloc_cb, (hc_free_cb_t)free_cb, &data))
+  {
+    puts("FAILED setting allocator.");
+    return (0);
+  }
+
+  css  = hcCSSNew(pool);
+  hcCSSImportDefault(css);
+  html = hcHTMLNew(pool, css);
+  file = hcFileNewString(pool, "<!DOCTYPE html>\n<html><head><title>Allocator Test</title></head><body><h1 id=\"title\">Heading</h1><p class=\"body\" style=\"color: red;\">Paragraph with <em>emphasis</em>.</p></body></html>\n");
+
+  hcHTMLImport(html, file);
+  hcFileDelete(file);
+
+  for (node = hcHTMLGetRootNode(html); node; node = next)
+  {
+    if (hcNodeGetElement(node) > HC_ELEMENT_DOCTYPE)
+      hcNodeComputeCSSProperties(node, HC_COMPUTE_BASE);
+
+    if ((next = hcNodeGetFirstChildNode(node)) == NULL)
+    {
+      while (node && (next = hcNodeGetNextSiblingNode(node)) == NULL)
+        node = hcNodeGetParentNode(node);
+    }
+  }
+
+  if (hcPoolSetAllocator(pool, NULL, NULL, NULL, NULL))
+  {
+    puts("FAILED changing allocator after use.");
+    return (0);
+  }
+
+  hcHTMLDelete(html);
+  hcCSSDelete(css);
+  hcPoolDelete(pool);
+
+  if (data.allocs == 0 || data.frees == 0)
+  {
+    puts("FAILED custom allocator was not used.");
+    return (0);
+  }
+
+  if (data.allocs != data.frees)
+  {
+    printf("FAILED %u allocations, %u frees.\n", (unsigned)data.allocs, (unsigned)data.frees);
+    return (0);
+  }
+
+  puts("PASSED custom memory allocator checks.\n");
+
+  return (1);
+}
+
+
+//
+// 'test_cache_functions()' - Test the URL cache directory.
+//
+
+static int				// O - 1 on success, 0 on failure
+test_cache_functions(void)
+{
+  int		i,			// Looping var
+		url_count = 0;		// Number of URL callbacks
+  hc_pool_t	*pool;			// Memory pool
+  const char	*url;			// Mapped URL
+  char		*cached = NULL,		// First cached URL
+		dirname[256],		// Cache directory
+		filename[1024],		// Cache filename
+		*a,			// Original file contents
+		*b;			// Cached file contents
+  size_t	alen,			// Length of original file
+		blen;			// Length of cached file
+  FILE		*fp;			// File
+  DIR		*dir;			// Directory
+  struct dirent	*dent;			// Directory entry
+  int		status = 1;		// Test status
+  static const char * const exturls[][2] =
+  {					// URLs and cached filename extensions
+    { "https://cache.example.com", "" },
+    { "https://cache.example.com/", "" },
+    { "https://cache.example.com?q=a.b", "" },
+    { "https://cache.example.com/page.HTML?v=1.2", ".html" },
+    { "https://cache.example.com/style.css#top.x", ".css" },
+    { "https://cache.example.com/dir.d/page?x=y.z#a.b", "" }
+  };
+
+
+  puts("Testing URL cache directory functions:\n");
+
+  snprintf(dirname, sizeof(dirname), "/tmp/testhtmlcss-%d", (int)getpid());
+
+  // Look up the same URL from two pools sharing the same cache directory...
+  for (i = 0; i < 2 && status; i ++)
+  {
+    pool = hcPoolNew("testhtmlcss");
+
+    hcPoolSetURLCallback(pool, url_cb, &url_count);
+
+    if (!hcPoolSetCacheDirectory(pool, dirname))
+    {
+      printf("FAILED setting cache directory '%s'.\n", dirname);
+      status = 0;
+    }
+    else if ((url = hcPoolGetURL(pool, "basic.html", "https://www.example.com/index.html")) == NULL || strncmp(url, dirname, strlen(dirname)))
+    {
+      printf("FAILED getting cached URL (got '%s')\n", url ? url : "(null)");
+      status = 0;
+    }
+    else if (i == 0)
+    {
+      // Compare the cached file to the original...
+      cached = strdup(url);
+      a      = NULL;
+      b      = NULL;
+      alen   = 0;
+      blen   = 0;
+
+      if ((fp = fopen("testsuite/basic.html", "rb")) != NULL)
+      {
+        a    = malloc(65536);
+        alen = fread(a, 1, 65536, fp);
+        fclose(fp);
+      }
+
+      if ((fp = fopen(url, "rb")) != NULL)
+      {
+        b    = malloc(65536);
+        blen = fread(b, 1, 65536, fp);
+        fclose(fp);
+      }
+
+      if (!a || !b || alen != blen || memcmp(a, b, alen))
+      {
+        printf("FAILED cached file '%s' does not match original.\n", url);
+        status = 0;
+      }
+
+      free(a);
+      free(b);
+    }
+    else if (!cached || strcmp(url, cached))
+    {
+      printf("FAILED cached URL '%s' does not match '%s'.\n", url, cached ? cached : "(null)");
+      status = 0;
+    }
+    else if (url_count != 1)
+    {
+      printf("FAILED URL callback called %d times, expected 1.\n", url_count);
+      status = 0;
+    }
+
+    hcPoolDelete(pool);
+  }
+
+  free(cached);
+
+  // Cached filenames only use the extension from the URL path...
+  pool = hcPoolNew("testhtmlcss");
+
+  hcPoolSetURLCallback(pool, url_cb, &url_count);
+  hcPoolSetCacheDirectory(pool, dirname);
+
+  for (i = 0; i < (int)(sizeof(exturls) / sizeof(exturls[0])) && status; i ++)
+  {
+    const char *name;			// Cached filename without directory
+
+    if ((url = hcPoolGetURL(pool, exturls[i][0], NULL)) == NULL || (name = strrchr(url, '/')) == NULL || strlen(name + 1) != (2 * HC_SHA3_256_SIZE + strlen(exturls[i][1])) || strcmp(name + 1 + 2 * HC_SHA3_256_SIZE, exturls[i][1]))
+    {
+      printf("FAILED cached filename for '%s' (got '%s', expected extension '%s').\n", exturls[i][0], url ? url : "(null)", exturls[i][1]);
+      status = 0;
+    }
+  }
+
+  hcPoolDelete(pool);
+
+  // Clean up the cache directory...
+  if ((dir = opendir(dirname)) != NULL)
+  {
+    while ((dent = readdir(dir)) != NULL)
+    {
+      if (strcmp(dent->d_name, ".") && strcmp(dent->d_name, ".."))
+      {
+        snprintf(filename, sizeof(filename), "%s/%s", dirname, dent->d_name);
+        unlink(filename);
+      }
+    }
+
+    closedir(dir);
+  }
+
+  rmdir(dirname);
+
+  if (status)
+    puts("PASSED URL cache directory checks.\n");
+
+  return (status);
+}
+
+
+//
+// 'test_charref_functions()' - Test HTML character reference functions.
+//
+
+static int				// O - 1 on success, 0 on failure
+test_charref_functions(hc_pool_t *pool)	// I - Memory pool
+{
+  size_t		i;		// Looping var
+  int			len;		// Length of UTF-8 sequence
+  hc_css_t		*css;		// Stylesheet
+  hc_file_t		*file;		// File
+  hc_html_t		*html;		// Imported HTML document
+  hc_node_t		*node;		// Paragraph node
+  const char		*value = NULL;	// Attribute value or text
+  const unsigned char	*s;		// Pointer into text
+  static const char	*refdoc = "<!DOCTYPE html>\n<p title=\"a&amp;b &lt&#x263a;\" alt=x&amp=1 name=\"&notit; &copy2\">&lt;&#65;&#x1F600; &copy 2024 &notanentity; &notit; &notin; &#; &#128;&amp</p>\n";
+					// Character reference document
+  static const char	*utf8 = "<A\360\237\230\200 \302\251 2024 \302\254anentity; \302\254it; \342\210\211 &#; \342\202\254&";
+					// Expected UTF-8 text
+
+
+  puts("Testing HTML character reference functions:\n");
+
+  // Character references are decoded in text and attribute values...
+  css  = hcCSSNew(pool);
+  html = hcHTMLNew(pool, css);
+  file = hcFileNewString(pool, refdoc);
+
+  if (!hcHTMLImport(html, file))
+  {
+    puts("FAILED importing character reference document.");
+    return (0);
+  }
+
+  hcFileDelete(file);
+
+  if ((node = hcHTMLFindNode(html, NULL, HC_ELEMENT_P, NULL)) == NULL || (value = hcNodeAttrGetNameValue(node, "title")) == NULL || strcmp(value, "a&b <\342\230\272") || (value = hcNodeAttrGetNameValue(node, "alt")) == NULL || strcmp(value, "x&amp=1") || (value = hcNodeAttrGetNameValue(node, "name")) == NULL || strcmp(value, "&notit; &copy2"))
+  {
+    printf("FAILED decoding attribute references, got \"%s\".\n", value ? value : "(null)");
+    return (0);
+  }
+
+  if ((node = hcNodeGetFirstChildNode(node)) == NULL || (value = hcNodeGetString(node)) == NULL || strcmp(value, utf8))
+  {
+    printf("FAILED decoding text references, got \"%s\".\n", value ? value : "(null)");
+    return (0);
+  }
+
+  // Show the decoded text one character at a time and make sure every
+  // multi-byte sequence is well-formed...
+  for (s = (const unsigned char *)value; *s; s += len)
+  {
+    if (*s < 0x80)
+      len = 1;
+    else if ((*s & 0xe0) == 0xc0)
+      len = 2;
+    else if ((*s & 0xf0) == 0xe0)
+      len = 3;
+    else if ((*s & 0xf8) == 0xf0)
+      len = 4;
+    else
+      len = 0;
+
+    for (i = 1; len > 0 && i < (size_t)len; i ++)
+    {
+      if ((s[i] & 0xc0) != 0x80)
+        len = 0;
+    }
+
+    if (len == 0)
+    {
+      printf("FAILED bad UTF-8 sequence at offset %u of decoded text.\n", (unsigned)(s - (const unsigned char *)value));
+      return (0);
+    }
+
+    if (len > 1)
+    {
+      printf("    ");
+      for (i = 0; i < (size_t)len; i ++)
+        printf("\\%03o", s[i]);
+      printf(" (%.*s)\n", len, s);
+    }
+  }
+
+  hcHTMLDelete(html);
+  hcCSSDelete(css);
+
+  puts("PASSED HTML character reference checks.\n");
+
+  return (1);
+}
+
+
+//
+// 'test_compute_functions() - Test CSS computation functions.
+//
+
+static int				// O - 1 on success, 0 on failure
+test_compute_functions(hc_pool_t *pool)	// I - Memory pool
+{
+  int			i;		// Looping var
+  hc_pool_t		*rpool;		// Memory pool for reset checks
+  hc_css_t		*css;		// Stylesheet
+  hc_html_t		*html;		// HTML document
+  hc_file_t		*file;		// File
+  hc_node_t		*node;		// Paragraph node
+  const hc_dict_t	*props;		// Computed properties
+  const char		*value;		// Property value
+  char			empty[1] = "";	// Empty string that is not interned
+  static const char	*cssdoc = "p[title=\"\"] { font-style: italic; }\n.a { font-weight: bold; }\n#b { text-decoration: underline; }\n";
+					// Stylesheet document
+  static const char	*htmldoc = "<!DOCTYPE html>\n<html><body><p title=\"\" class=\"a\" id=\"b\">One</p><p>Two</p></body></html>\n";
+					// HTML document
+  static const char	*resetdocs[3][2] =
+  {					// Documents for reset checks
+    { "<!DOCTYPE html>\n<p class=\"a\" style=\"margin-left: 7px;\">First document</p>\n", "7px" },
+    { "<!DOCTYPE html>\n<p title=\"Shifted strings\" class=\"a\" style=\"margin-left: 7px;\">First document</p>\n", "7px" },
+    { "<!DOCTYPE html>\n<p class=\"a\" style=\"margin-left: 9px;\">Second document</p>\n", "9px" }
+  };
+
+
+  puts("Testing CSS computation functions:\n");
+
+  css  = hcCSSNew(pool);
+  file = hcFileNewString(pool, cssdoc);
+
+  if (!hcCSSImport(css, file))
+  {
+    puts("FAILED importing stylesheet.");
+    return (0);
+  }
+
+  hcFileDelete(file);
+
+  html = hcHTMLNew(pool, css);
+  file = hcFileNewString(pool, htmldoc);
+
+  if (!hcHTMLImport(html, file))
+  {
+    puts("FAILED importing document.");
+    return (0);
+  }
+
+  hcFileDelete(file);
+
+  // The second paragraph gets its attributes from the API, with an empty value
+  // that doesn't come from the pool...
+  if ((node = hcHTMLFindNode(html, NULL, HC_ELEMENT_P, NULL)) == NULL || (node = hcNodeGetNextSiblingNode(node)) == NULL)
+  {
+    puts("FAILED finding paragraphs.");
+    return (0);
+  }
+
+  hcNodeAttrSetNameValue(node, "title", empty);
+  hcNodeAttrSetNameValue(node, "class", "a");
+  hcNodeAttrSetNameValue(node, "id", "b");
+
+  for (i = 0, node = hcHTMLFindNode(html, NULL, HC_ELEMENT_P, NULL); node; i ++, node = hcHTMLFindNode(html, node, HC_ELEMENT_P, NULL))
+  {
+    if ((props = hcNodeComputeCSSProperties(node, HC_COMPUTE_BASE)) == NULL)
+    {
+      printf("FAILED computing properties for paragraph %d.\n", i + 1);
+      return (0);
+    }
+
+    if ((value = hcDictGetKeyValue(props, "font-style")) == NULL || strcmp(value, "italic"))
+    {
+      printf("FAILED matching empty attribute value for paragraph %d, got \"%s\".\n", i + 1, value ? value : "(null)");
+      return (0);
+    }
+
+    if ((value = hcDictGetKeyValue(props, "font-weight")) == NULL || strcmp(value, "bold"))
+    {
+      printf("FAILED matching class for paragraph %d, got \"%s\".\n", i + 1, value ? value : "(null)");
+      return (0);
+    }
+
+    if ((value = hcDictGetKeyValue(props, "text-decoration")) == NULL || strcmp(value, "underline"))
+    {
+      printf("FAILED matching id for paragraph %d, got \"%s\".\n", i + 1, value ? value : "(null)");
+      return (0);
+    }
+  }
+
+  if (i != 2)
+  {
+    printf("FAILED finding paragraphs, got %d.\n", i);
+    return (0);
+  }
+
+  hcHTMLDelete(html);
+  hcCSSDelete(css);
+
+  // Load the same stylesheet into a separate pool and then load, compute, and
+  // reset for a series of documents...
+  rpool = hcPoolNew("testhtmlcss");
+  css   = hcCSSNew(rpool);
+  file  = hcFileNewString(rpool, cssdoc);
+
+  hcCSSImport(css, file);
+  hcFileDelete(file);
+
+  hcPoolMark(rpool);
+
+  for (i = 0; i < (int)(sizeof(resetdocs) / sizeof(resetdocs[0])); i ++)
+  {
+    html = hcHTMLNew(rpool, css);
+    file = hcFileNewString(rpool, resetdocs[i][0]);
+
+    hcHTMLImport(html, file);
+    hcFileDelete(file);
+
+    if ((node = hcHTMLFindNode(html, NULL, HC_ELEMENT_P, NULL)) == NULL || (props = hcNodeComputeCSSProperties(node, HC_COMPUTE_BASE)) == NULL)
+    {
+      printf("FAILED computing properties for reset document %d.\n", i + 1);
+      return (0);
+    }
+
+    if ((value = hcDictGetKeyValue(props, "font-weight")) == NULL || strcmp(value, "bold") || (value = hcDictGetKeyValue(props, "margin-left")) == NULL || strcmp(value, resetdocs[i][1]))
+    {
+      printf("FAILED computed properties for reset document %d, got \"%s\".\n", i + 1, value ? value : "(null)");
+      return (0);
+    }
+
+    if ((node = hcNodeGetFirstChildNode(node)) == NULL || (value = hcNodeGetString(node)) == NULL || !strstr(resetdocs[i][0], value))
+    {
+      printf("FAILED text for reset document %d, got \"%s\".\n", i + 1, value ? value : "(null)");
+      return (0);
+    }
+
+    hcHTMLDelete(html);
+    hcPoolReset(rpool);
+  }
+
+  hcCSSDelete(css);
+  hcPoolDelete(rpool);
+
+  puts("PASSED CSS computation checks.\n");
+
+  return (1);
+}
+
+
+//
+// 'test_dict_functions()' - Test dictionary functions.
+//
+
+static int				// O - 1 on success, 0 on failure
+test_dict_functions(hc_pool_t *pool)	// I - Memory pool
+{
+  int		i;			// Looping var
+  hc_dict_t	*dict,			// Dictionary
+		*copy;			// Copy of dictionary
+  const char	*key,			// Current key
+		*value,			// Current value
+		*prev = NULL;		// Previous key
+  char		name[32],		// Key string
+		temp[32];		// Value string
+
+
+  puts("Testing dictionary functions:\n");
+
+  if ((dict = hcDictNew(pool)) == NULL)
+  {
+    puts("FAILED creating dictionary.");
+    return (0);
+  }
+
+  // Add keys out of order...
+  for (i = 0; i < 100; i ++)
+  {
+    snprintf(name, sizeof(name), "key-%03d", (i * 37) % 100);
+    snprintf(temp, sizeof(temp), "value-%d", i);
+    hcDictSetKeyValue(dict, name, temp);
+  }
+
+  if (hcDictGetCount(dict) != 100)
+  {
+    printf("FAILED dictionary has %u pairs, expected 100.\n", (unsigned)hcDictGetCount(dict));
+    return (0);
+  }
+
+  for (i = 0; i < 100; i ++)
+  {
+    if ((value = hcDictGetIndexKeyValue(dict, (size_t)i, &key)) == NULL || (prev && strcasecmp(prev, key) >= 0))
+    {
+      printf("FAILED dictionary pair #%d is out of order.\n", i + 1);
+      return (0);
+    }
+
+    prev = key;
+  }
+
+  puts("PASSED adding 100 keys.");
+
+  // Replace values, ignoring case...
+  hcDictSetKeyValue(dict, "KEY-042", "replaced");
+
+  if (hcDictGetCount(dict) != 100 || (value = hcDictGetKeyValue(dict, "key-042")) == NULL || strcmp(value, "replaced"))
+  {
+    puts("FAILED replacing value.");
+    return (0);
+  }
+
+  puts("PASSED replacing value.");
+
+  // Remove keys...
+  hcDictRemoveKey(dict, "key-000");
+  hcDictRemoveKey(dict, "key-099");
+
+  if (hcDictGetCount(dict) != 98 || hcDictGetKeyValue(dict, "key-000") || hcDictGetKeyValue(dict, "key-099") || !hcDictGetKeyValue(dict, "key-050"))
+  {
+    puts("FAILED removing keys.");
+    return (0);
+  }
+
+  // Freeze the dictionary and look up keys using the perfect hash table...
+  if (!hcDictFreeze(dict))
+  {
+    puts("FAILED freezing dictionary.");
+    return (0);
+  }
+
+  for (i = 1; i < 99; i ++)
+  {
+    snprintf(name, sizeof(name), "KEY-%03d", i);
+
+    if (!hcDictGetKeyValue(dict, name))
+    {
+      printf("FAILED looking up '%s' in frozen dictionary.\n", name);
+      return (0);
+    }
+  }
+
+  if (hcDictGetKeyValue(dict, "key-000") || hcDictGetKeyValue(dict, "key-100") || hcDictGetKeyValue(dict, "missing"))
+  {
+    puts("FAILED looking up missing keys in frozen dictionary.");
+    return (0);
+  }
+
+  puts("PASSED frozen dictionary lookups.");
+
+  // Copy large and small dictionaries...
+  if ((copy = hcDictCopy(dict)) == NULL || hcDictGetCount(copy) != 98 || hcDictGetKeyValue(copy, "key-042") != hcDictGetKeyValue(dict, "key-042"))
+  {
+    puts("FAILED copying dictionary.");
+    return (0);
+  }
+
+  hcDictSetKeyValue(copy, "key-042", "changed");
+  hcDictRemoveKey(copy, "key-050");
+
+  if ((value = hcDictGetKeyValue(dict, "key-042")) == NULL || strcmp(value, "replaced") || !hcDictGetKeyValue(dict, "key-050") || hcDictGetCount(dict) != 98 || (value = hcDictGetKeyValue(copy, "key-042")) == NULL || strcmp(value, "changed") || hcDictGetCount(copy) != 97)
+  {
+    puts("FAILED changing copy of dictionary.");
+    return (0);
+  }
+
+  hcDictDelete(copy);
+  hcDictDelete(dict);
+
+  dict = hcDictNew(pool);
+  hcDictSetKeyValue(dict, "b", "2");
+  hcDictSetKeyValue(dict, "a", "1");
+
+  if ((copy = hcDictCopy(dict)) == NULL || hcDictGetCount(copy) != 2 || (value = hcDictGetIndexKeyValue(copy, 0, &key)) == NULL || strcmp(key, "a") || strcmp(value, "1"))
+  {
+    puts("FAILED copying small dictionary.");
+    return (0);
+  }
+
+  hcDictSetKeyValue(copy, "c", "3");
+
+  if (hcDictGetCount(dict) != 2 || hcDictGetCount(copy) != 3)
+  {
+    puts("FAILED changing copy of small dictionary.");
+    return (0);
+  }
+
+  hcDictDelete(copy);
+  hcDictDelete(dict);
+
+  puts("PASSED copying dictionaries.");
+
+  // Merge dictionaries...
+  dict = hcDictNew(pool);
+  copy = hcDictNew(pool);
+
+  for (i = 0; i < 20; i ++)
+  {
+    snprintf(name, sizeof(name), "key-%02d", i);
+    snprintf(temp, sizeof(temp), "dict-%d", i);
+    if (i & 1)
+      hcDictSetKeyValue(dict, name, temp);
+
+    snprintf(temp, sizeof(temp), "copy-%d", i);
+    if (i % 3)
+      hcDictSetKeyValue(copy, name, temp);
+  }
+
+  hcDictMerge(dict, copy, false);
+
+  if (hcDictGetCount(dict) != 16 || (value = hcDictGetKeyValue(dict, "key-01")) == NULL || strcmp(value, "dict-1") || (value = hcDictGetKeyValue(dict, "key-02")) == NULL || strcmp(value, "copy-2"))
+  {
+    puts("FAILED merging dictionaries.");
+    return (0);
+  }
+
+  hcDictMerge(dict, copy, true);
+
+  if (hcDictGetCount(dict) != 16 || (value = hcDictGetKeyValue(dict, "key-01")) == NULL || strcmp(value, "copy-1") || (value = hcDictGetKeyValue(dict, "key-03")) == NULL || strcmp(value, "dict-3"))
+  {
+    puts("FAILED merging dictionaries with overwrite.");
+    return (0);
+  }
+
+  for (i = 0, prev = NULL; i < 16; i ++)
+  {
+    if (!hcDictGetIndexKeyValue(dict, (size_t)i, &key) || (prev && strcasecmp(prev, key) >= 0))
+    {
+      printf("FAILED merged pair #%d is out of order.\n", i + 1);
+      return (0);
+    }
+
+    prev = key;
+  }
+
+  hcDictDelete(copy);
+  hcDictDelete(dict);
+
+  puts("PASSED merging dictionaries.");
+  puts("PASSED dictionary checks.\n");
+
+  return (1);
+}
+
+
+//
+// 'test_element_functions()' - Test element functions.
+//
+
+static int				// O - 1 on success, 0 on failure
+test_element_functions(void)
+{
+  hc_element_t	e;			// Current element
+  size_t	i;			// Looping var
+  char		name[256],		// Element name
+		*nameptr;		// Pointer into name
+  static const char * const unknowns[] =
+  {					// Names that are not elements
+    "",
+    "*",
+    "ab",
+    "abbrev",
+    "bodyx",
+    "doctype",
+    "h7",
+    "t\341ble"
+  };
+
+
+  puts("Testing element functions:\n");
+
+  for (e = HC_ELEMENT_COMMENT; e < HC_ELEMENT_MAX; e ++)
+  {
+    if (hcElementValue(hcElementString(e)) != e)
+    {
+      printf("FAILED looking up \"%s\".\n", hcElementString(e));
+      return (0);
+    }
+
+    // Try the uppercase name...
+    strncpy(name, hcElementString(e), sizeof(name) - 1);
+    name[sizeof(name) - 1] = '\0';
+
+    for (nameptr = name; *nameptr; nameptr ++)
+      *nameptr = (char)toupper(*nameptr & 255);
+
+    if (hcElementValue(name) != e)
+    {
+      printf("FAILED looking up \"%s\".\n", name);
+      return (0);
+    }
+  }
+
+  for (i = 0; i < (sizeof(unknowns) / sizeof(unknowns[0])); i ++)
+  {
+    if ((e = hcElementValue(unknowns[i])) != HC_ELEMENT_UNKNOWN)
+    {
+      printf("FAILED looking up \"%s\", got \"%s\".\n", unknowns[i], hcElementString(e));
+      return (0);
+    }
+  }
+
+  puts("PASSED element checks.\n");
+
+  return (1);
+}
+
+
+//
+// 'test_event_functions()' - Test HTML event functions.
+//
+
+static int				// O - 1 on success, 0 on failure
+test_event_functions(hc_pool_t *pool)	// I - Memory pool
+{
+  hc_file_t		*file;		// File
+  event_test_t		data;		// Event test data
+  static const hc_html_events_t events =
+  {					// Event callbacks
+    (hc_html_start_cb_t)event_start_cb,
+    (hc_html_end_cb_t)event_end_cb,
+    (hc_html_text_cb_t)event_text_cb,
+    (hc_html_comment_cb_t)event_comment_cb
+  };
+  static const char	*doc = "<!DOCTYPE html>\n<html><head><title>Events</title></head><!-- note --><body><p class=\"a\" id=b>One &amp; two<br>three<?x?><ul><li>A<li>B</ul></body></html>";
+					// Test document
+  static const char	*log = "<!DOCTYPE =html>[\n]<html><head><title>[Events]</title></head>{ note }<body><p class=a id=b>[One & two]<br></br>[three]<ul><li>[A]</li><li>[B]</li></ul></p></body></html></!DOCTYPE>";
+					// Expected event log
+
+
+  puts("Testing HTML event functions:\n");
+
+  // Parse the whole document...
+  memset(&data, 0, sizeof(data));
+
+  file = hcFileNewString(pool, doc);
+
+  if (!hcHTMLParse(file, &events, &data))
+  {
+    puts("FAILED parsing document.");
+    return (0);
+  }
+
+  hcFileDelete(file);
+
+  if (strcmp(data.log, log))
+  {
+    printf("FAILED events do not match, got \"%s\".\n", data.log);
+    return (0);
+  }
+
+  // Stop after the title text...
+  memset(&data, 0, sizeof(data));
+  data.stop = 5;
+
+  file = hcFileNewString(pool, doc);
+
+  if (hcHTMLParse(file, &events, &data))
+  {
+    puts("FAILED parsing did not stop.");
+    return (0);
+  }
+
+  hcFileDelete(file);
+
+  if (data.count != 5 || strcmp(data.log, "<!DOCTYPE =html>[\n]<html><head><title>"))
+  {
+    printf("FAILED stopped events do not match, got \"%s\".\n", data.log);
+    return (0);
+  }
+
+  // Open elements are still closed after a parse error...
+  memset(&data, 0, sizeof(data));
+
+  file = hcFileNewString(pool, "<!DOCTYPE html><p>One<!DOCTYPE html><p>Two");
+
+  if (hcHTMLParse(file, &events, &data))
+  {
+    puts("FAILED parsing did not report error.");
+    return (0);
+  }
+
+  hcFileDelete(file);
+
+  if (strcmp(data.log, "<!DOCTYPE =html><p>[One]</p></!DOCTYPE>"))
+  {
+    printf("FAILED error events do not match, got \"%s\".\n", data.log);
+    return (0);
+  }
+
+  puts("PASSED HTML event checks.\n");
+
+  return (1);
+}
+
+
+//
+// 'test_file_functions()' - Test file functions.
+//
+
+static int				// O - 1 on success, 0 on failure
+test_file_functions(hc_pool_t *pool)	// I - Memory pool
+{
+  hc_file_t	*file;			// File
+  const char	*data;			// Scanned data
+  size_t	datalen;		// Length of scanned data
+  gzFile	gz;			// Compressed test file
+  char		filename[256],		// Compressed test filename
+		buffer[256];		// Read buffer
+  static const char *text = "A long run of text without delimiters<b>bold</b>\nnext line";
+					// Test text
+
+
+  puts("Testing file functions:\n");
+
+  if ((file = hcFileNewString(pool, text)) == NULL)
+  {
+    puts("FAILED creating string file.");
+    return (0);
+  }
+
+  datalen = 1024;
+  if (!hcFileScan(file, "<\n", &data, &datalen) || datalen != 37 || strncmp(data, text, datalen) || hcFileGetc(file) != '<')
+  {
+    printf("FAILED scanning text, got %u bytes.\n", (unsigned)datalen);
+    return (0);
+  }
+
+  datalen = 1024;
+  if (!hcFileScan(file, "<\n", &data, &datalen) || datalen != 6 || strncmp(data, "b>bold", datalen))
+  {
+    printf("FAILED scanning element, got %u bytes.\n", (unsigned)datalen);
+    return (0);
+  }
+
+  datalen = 1024;
+  if (!hcFileScan(file, "<\n", &data, &datalen) || datalen != 0)
+  {
+    printf("FAILED scanning at delimiter, got %u bytes.\n", (unsigned)datalen);
+    return (0);
+  }
+
+  datalen = 3;
+  if (!hcFileScan(file, "\n", &data, &datalen) || datalen != 3 || strncmp(data, "</b", datalen) || hcFileGetc(file) != '>')
+  {
+    printf("FAILED scanning with limit, got %u bytes.\n", (unsigned)datalen);
+    return (0);
+  }
+
+  datalen = 1024;
+  if (!hcFileScan(file, "\n", &data, &datalen) || datalen != 0 || hcFileGetc(file) != '\n')
+  {
+    printf("FAILED scanning newline, got %u bytes.\n", (unsigned)datalen);
+    return (0);
+  }
+
+  datalen = 1024;
+  if (!hcFileScan(file, "<", &data, &datalen) || datalen != 9 || strncmp(data, "next line", datalen))
+  {
+    printf("FAILED scanning to end-of-file, got %u bytes.\n", (unsigned)datalen);
+    return (0);
+  }
+
+  datalen = 1024;
+  if (hcFileScan(file, "<", &data, &datalen))
+  {
+    puts("FAILED scanning past end-of-file.");
+    return (0);
+  }
+
+  hcFileDelete(file);
+
+  // Test reading and returning characters with a compressed file...
+  snprintf(filename, sizeof(filename), "/tmp/testhtmlcss-%d.gz", (int)getpid());
+
+  if ((gz = gzopen(filename, "wb")) == NULL)
+  {
+    printf("FAILED creating '%s'.\n", filename);
+    return (0);
+  }
+
+  gzputs(gz, "abcdef\nghi\njkl\n");
+  gzclose(gz);
+
+  file = hcFileNewURL(pool, filename, NULL);
+  unlink(filename);
+
+  if (!file)
+  {
+    printf("FAILED opening '%s'.\n", filename);
+    return (0);
+  }
+
+  if (hcFileRead(file, buffer, 4) != 4 || memcmp(buffer, "abcd", 4))
+  {
+    puts("FAILED reading compressed file.");
+    return (0);
+  }
+
+  hcFileUngetc(file, 'd');
+
+  if (hcFileGetc(file) != 'd')
+  {
+    puts("FAILED returning character after compressed read.");
+    return (0);
+  }
+
+  if (hcFileRead(file, buffer, 6) != 6 || memcmp(buffer, "ef\nghi", 6) || _hcFileGetLine(file) != 2)
+  {
+    printf("FAILED counting lines after compressed read, got line %d.\n", _hcFileGetLine(file));
+    return (0);
+  }
+
+  if (hcFileGetc(file) != '\n' || _hcFileGetLine(file) != 3)
+  {
+    printf("FAILED counting lines after compressed newline, got line %d.\n", _hcFileGetLine(file));
+    return (0);
+  }
+
+  hcFileDelete(file);
+
+  puts("PASSED file checks.\n");
+
+  return (1);
+}
+
+
+//
+// 'test_parser_functions()' - Test HTML push parser functions.
+//
+
+static int				// O - 1 on success, 0 on failure
+test_parser_functions(hc_pool_t *pool)	// I - Memory pool
+{
+  size_t		i,		// Looping var
+			len;		// Length of document
+  hc_css_t		*css;		// Stylesheet
+  hc_file_t		*file;		// File
+  hc_html_t		*html,		// Imported HTML document
+			*lhtml,		// Imported long document
+			*phtml;		// Parsed HTML document
+  hc_html_parser_t	*parser;	// HTML push parser
+  hc_node_t		*node;		// Paragraph text node
+  const char		*name,		// Attribute name
+			*value;		// Attribute value
+  char			*longdoc,	// Document with long markup
+			*longptr;	// Pointer into document
+  static const char	*doc = "<!DOCTYPE html>\n<html><head><title>Parser Test</title></head>\n<!-- comment with <b>markup</b> -->\n<body><p class=\"a>b\" id=first>One line,\nanother line, and 0 < x <= 1.</p><?unknown directive?>\n<ul><li>One<li>Two</ul></body></html>\n";
+					// Test document
+  static const char	*unkdocs[] =	// Unknown element documents
+  {
+    "<foo><p>One</p>\n",
+    "<!DOCTYPE html>\n<body><foo><p>One</p></body>\n"
+  };
+
+
+  puts("Testing HTML push parser functions:\n");
+
+  css = hcCSSNew(pool);
+  len = strlen(doc);
+
+  // Import the document all at once...
+  html = hcHTMLNew(pool, css);
+  file = hcFileNewString(pool, doc);
+
+  if (!hcHTMLImport(html, file))
+  {
+    puts("FAILED importing document.");
+    return (0);
+  }
+
+  hcFileDelete(file);
+
+  // Then feed it one byte at a time...
+  phtml = hcHTMLNew(pool, css);
+
+  if ((parser = hcHTMLParserNew(phtml, "parser-test")) == NULL)
+  {
+    puts("FAILED creating parser.");
+    return (0);
+  }
+
+  for (i = 0; i < len; i ++)
+  {
+    if (!hcHTMLParserFeed(parser, doc + i, 1))
+    {
+      printf("FAILED feeding byte %u.\n", (unsigned)i);
+      return (0);
+    }
+
+    if (i == 20 && !hcHTMLGetRootNode(phtml))
+    {
+      puts("FAILED to parse <!DOCTYPE html> before end of document.");
+      return (0);
+    }
+  }
+
+  if (!hcHTMLParserFinish(parser))
+  {
+    puts("FAILED finishing parser.");
+    return (0);
+  }
+
+  if (!compare_nodes(hcHTMLGetRootNode(html), hcHTMLGetRootNode(phtml)))
+  {
+    puts("FAILED parsed document does not match imported document.");
+    return (0);
+  }
+
+  if ((node = hcHTMLFindNode(phtml, NULL, HC_ELEMENT_P, NULL)) == NULL || (node = hcNodeGetFirstChildNode(node)) == NULL || !hcNodeGetString(node) || strcmp(hcNodeGetString(node), "One line,\nanother line, and 0 < x <= 1."))
+  {
+    puts("FAILED text was not added as a single string node.");
+    return (0);
+  }
+
+  // Known attribute names use the pooled strings...
+  node = hcHTMLFindNode(phtml, NULL, HC_ELEMENT_P, NULL);
+
+  if ((value = hcNodeAttrGetIndexNameValue(node, 0, &name)) == NULL || name != hcPoolGetString(pool, "class") || strcmp(value, "a>b") || (value = hcNodeAttrGetIndexNameValue(node, 1, &name)) == NULL || name != hcPoolGetString(pool, "id") || strcmp(value, "first"))
+  {
+    puts("FAILED known attributes were not added.");
+    return (0);
+  }
+
+  hcHTMLDelete(phtml);
 
-	for (j = 0, stmt = sel->stmts; j < (int)sel->num_stmts; j ++, stmt ++)
-	{
-	  switch (stmt->match)
-	  {
-	    case _HC_MATCH_ATTR_EXIST :
-		printf("[%s]", stmt->name);
-		break;
-	    case _HC_MATCH_ATTR_EQUALS :
-		printf("[%s=\"%s\"]", stmt->name, stmt->value);
-		break;
-	    case _HC_MATCH_ATTR_CONTAINS :
-		printf("[%s*=\"%s\"]", stmt->name, stmt->value);
-		break;
-	    case _HC_MATCH_ATTR_BEGINS :
-		printf("[%s^=\"%s\"]", stmt->name, stmt->value);
-		break;
-	    case _HC_MATCH_ATTR_ENDS :
-		printf("[%s$=\"%s\"]", stmt->name, stmt->value);
-		break;
-	    case _HC_MATCH_ATTR_LANG :
-		printf("[%s|=\"%s\"]", stmt->name, stmt->value);
-		break;
-	    case _HC_MATCH_ATTR_SPACE :
-		printf("[%s~=\"%s\"]", stmt->name, stmt->value);
-		break;
-	    case _HC_MATCH_CLASS :
-		printf(".%s", stmt->name);
-		break;
-	    case _HC_MATCH_ID :
-		printf("#%s", stmt->name);
-		break;
-	    case _HC_MATCH_PSEUDO_CLASS :
-		if (stmt->value)
-		  printf(":%s(%s)", stmt->name, stmt->value);
-		else
-		  printf(":%s", stmt->name);
-		break;
-	  }
-	}
+  // Markup that is too long for the parsing buffers doesn't hold up parsing
+  // and is parsed the same way as when it is imported...
+  if ((longdoc = malloc(32768)) == NULL)
+  {
+    puts("FAILED allocating long document.");
+    return (0);
+  }
 
-	putchar(' ');
-      }
+  longptr = longdoc + strlen(strcpy(longdoc, "<!DOCTYPE html "));
+  memset(longptr, 'D', 3000);
+  longptr += 3000;
+  longptr += strlen(strcpy(longptr, ">\n<body><img src=\""));
+  memset(longptr, 'A', 3000);
+  longptr += 3000;
+  longptr += strlen(strcpy(longptr, "\" alt="));
+  memset(longptr, 'B', 3000);
+  longptr += 3000;
+  longptr += strlen(strcpy(longptr, "><!-- a -- b -"));
+  memset(longptr, 'C', 9000);
+  longptr += 9000;
+  longptr += strlen(strcpy(longptr, "---><?unknown "));
+  memset(longptr, 'U', 3000);
+  longptr += 3000;
+  strcpy(longptr, " \"?>\"?><p>Long</p>\n");
+
+  len   = strlen(longdoc);
+  lhtml = hcHTMLNew(pool, css);
+  file  = hcFileNewString(pool, longdoc);
+
+  hcHTMLImport(lhtml, file);
+  hcFileDelete(file);
+
+  phtml = hcHTMLNew(pool, css);
+
+  if ((parser = hcHTMLParserNew(phtml, "long-test")) == NULL)
+  {
+    puts("FAILED creating parser.");
+    return (0);
+  }
 
-      putchar('<');
-      for (j = 0; j < HC_SHA3_256_SIZE; j ++)
-	printf("%02X", rule->hash[j]);
-      putchar('>');
-      putchar(' ');
-      puts("{");
+  for (i = 0; i < len; i ++)
+    hcHTMLParserFeed(parser, longdoc + i, 1);
 
-      for (pindex = 0, pcount = hcDictGetCount(rule->props); pindex < pcount; pindex ++)
-      {
-	pvalue = hcDictGetIndexKeyValue(rule->props, pindex, &pname);
-	printf("  %s: %s;\n", pname, pvalue);
-      }
+  if (!hcHTMLFindNode(phtml, NULL, HC_ELEMENT_P, NULL))
+  {
+    puts("FAILED to parse <p> after long markup before end of document.");
+    return (0);
+  }
 
-      puts("}");
-    }
+  hcHTMLParserFinish(parser);
+
+  if (!compare_nodes(hcHTMLGetRootNode(lhtml), hcHTMLGetRootNode(phtml)))
+  {
+    puts("FAILED parsed long document does not match imported document.");
+    return (0);
   }
 
-  if (show_font_cache)
+  hcHTMLDelete(lhtml);
+  hcHTMLDelete(phtml);
+  free(longdoc);
+
+  // Unknown elements don't consume the following markup...
+  for (i = 0; i < (sizeof(unkdocs) / sizeof(unkdocs[0])); i ++)
   {
-    size_t	findex,			// Font index
-		num_fonts;		// Number of cached fonts
-    ttf_t	*font;			// Cached font
+    phtml = hcHTMLNew(pool, css);
+    file  = hcFileNewString(pool, unkdocs[i]);
 
-    printf("\nCached Fonts (%lu):\n", (unsigned long)ttfCacheGetNumFonts(pool->fonts));
+    hcHTMLImport(phtml, file);
+    hcFileDelete(file);
 
-    for (findex = 0, num_fonts = ttfCacheGetNumFonts(pool->fonts); findex < num_fonts; findex ++)
+    if ((node = hcHTMLFindNode(phtml, NULL, HC_ELEMENT_P, NULL)) == NULL || (node = hcNodeGetFirstChildNode(node)) == NULL || (value = hcNodeGetString(node)) == NULL || strcmp(value, "One"))
     {
-      if ((font = ttfCacheGetFont(pool->fonts, findex)) != NULL)
-      {
-        ttf_style_t style = ttfGetStyle(font);
-
-        printf("  \"%s\" (%s) %s %d\n", ttfGetFamily(font), ttfGetPostScriptName(font), style == TTF_STYLE_NORMAL ? "normal" : style == TTF_STYLE_ITALIC ? "italic" : "oblique", ttfGetWeight(font));
-      }
+      printf("FAILED importing unknown element document %u.\n", (unsigned)i);
+      return (0);
     }
+
+    hcHTMLDelete(phtml);
   }
 
   hcHTMLDelete(html);
   hcCSSDelete(css);
-  hcPoolDelete(pool);
-
-  return (0);
-}
-
 
-//
-// 'error_cb()' - Error callback for HTMLCSS...
-//
-
-static bool				// O - `true` to continue
-error_cb(void       *ctx,		// I - User data (not used)
-         const char *message,		// I - Message string (not used)
-         int        linenum)		// I - Line number (not used)
-{
-  (void)ctx;
-  (void)message;
-  (void)linenum;
+  puts("PASSED HTML push parser checks.\n");
 
-  return (true);
+  return (1);
 }
 
 
@@ -419,6 +1865,10 @@ test_pool_functions(hc_pool_t *pool)	// I - Memory pool
   int		i, j;			// Looping vars
   const char	*strings[235],		// Strings from memory pool
 		*temp;			// Temporary string pointer
+  char		longstr[8192];		// Long string
+  hc_atom_t	atom;			// Atom for string
+  int		url_count = 0;		// Number of URL callbacks
+  hc_pool_stats_t stats;		// Pool statistics
   static const char * const words[235] =// Test strings
   {
     "accordant",
@@ -707,10 +2157,248 @@ test_pool_functions(hc_pool_t *pool)	// I - Memory pool
     }
   }
 
-  printf("PASSED string reuse checks of %d word strings in pool.\n\n", i);
+  printf("PASSED string reuse checks of %d word strings in pool.\n", i);
+
+  for (i = 0; i < (int)(sizeof(words) / sizeof(words[0])); i ++)
+  {
+    snprintf(longstr, sizeof(longstr), "%s-suffix", words[i]);
+
+    if (hcPoolGetStringLen(pool, longstr, strlen(words[i])) != strings[i])
+    {
+      printf("FAILED word string #%d ('%s') did not reuse pointer for length-aware lookup.\n", i + 1, words[i]);
+      return (0);
+    }
+  }
+
+  printf("PASSED length-aware reuse checks of %d word strings in pool.\n", i);
+
+  for (i = 0; i < (int)(sizeof(words) / sizeof(words[0])); i ++)
+  {
+    hc_atom_t	lower;			// Atom for lowercase word
+
+    for (j = 0; words[i][j]; j ++)
+      longstr[j] = (char)tolower(words[i][j] & 255);
+    longstr[j] = '\0';
+
+    if ((atom = hcPoolGetAtom(pool, words[i])) == 0 || hcPoolAtomString(pool, atom) != strings[i])
+    {
+      printf("FAILED word string #%d ('%s') has the wrong atom.\n", i + 1, words[i]);
+      return (0);
+    }
+    else if ((lower = hcPoolAtomLower(pool, atom)) != hcPoolGetAtom(pool, longstr) || strcmp(hcPoolAtomString(pool, lower), longstr))
+    {
+      printf("FAILED word string #%d ('%s') has the wrong lowercase atom.\n", i + 1, words[i]);
+      return (0);
+    }
+  }
+
+  printf("PASSED atom checks of %d word strings in pool.\n", i);
+
+  memset(longstr, 'x', sizeof(longstr) - 1);
+  longstr[sizeof(longstr) - 1] = '\0';
+
+  if ((temp = hcPoolGetString(pool, longstr)) == NULL || strcmp(temp, longstr))
+  {
+    puts("FAILED adding long string to pool.");
+    return (0);
+  }
+  else if (hcPoolGetString(pool, longstr) != temp)
+  {
+    puts("FAILED long string did not reuse pointer.");
+    return (0);
+  }
+
+  for (i = 0; i < (int)(sizeof(words) / sizeof(words[0])); i ++)
+  {
+    if (hcPoolGetString(pool, words[i]) != strings[i])
+    {
+      printf("FAILED word string #%d ('%s') did not reuse pointer after long string.\n", i + 1, words[i]);
+      return (0);
+    }
+  }
+
+  puts("PASSED long string checks.");
+
+  hcPoolSetURLCallback(pool, url_cb, &url_count);
+
+  for (i = 0; i < 2; i ++)
+  {
+    const char	*url;			// Mapped URL
+
+    if ((url = hcPoolGetURL(pool, "found.html", "https://www.example.com/index.html")) == NULL || strcmp(url, "found.html"))
+    {
+      printf("FAILED getting found URL (got '%s')\n", url ? url : "(null)");
+      return (0);
+    }
+    else if ((url = hcPoolGetURL(pool, "missing.html", "https://www.example.com/index.html")) != NULL)
+    {
+      printf("FAILED getting missing URL (got '%s')\n", url);
+      return (0);
+    }
+  }
+
+  if (url_count != 2)
+  {
+    printf("FAILED URL callback called %d times, expected 2.\n", url_count);
+    return (0);
+  }
+
+  hcPoolSetURLCallback(pool, url_cb, &url_count);
+
+  if (!hcPoolGetURL(pool, "found.html", "https://www.example.com/index.html") || url_count != 3)
+  {
+    puts("FAILED URL cache not cleared when callback changed.");
+    return (0);
+  }
+
+  hcPoolSetURLCallback(pool, NULL, NULL);
+
+  puts("PASSED URL cache checks.");
+
+  if (!hcPoolGetStats(pool, &stats))
+  {
+    puts("FAILED getting pool statistics.");
+    return (0);
+  }
+  else if (stats.num_strings < 235 || stats.string_bytes < sizeof(longstr) || stats.storage_bytes < stats.string_bytes || stats.intern_hits < 235 || stats.intern_misses < stats.num_strings || stats.url_hits != 2)
+  {
+    printf("FAILED pool statistics (%lu strings, %lu/%lu bytes, %lu hits, %lu misses, %lu URL hits)\n", (unsigned long)stats.num_strings, (unsigned long)stats.string_bytes, (unsigned long)stats.storage_bytes, (unsigned long)stats.intern_hits, (unsigned long)stats.intern_misses, (unsigned long)stats.url_hits);
+    return (0);
+  }
+
+  puts("PASSED pool statistics checks.");
+
+  hcPoolMark(pool);
+
+  if ((atom = hcPoolGetAtom(pool, "post-mark string")) == 0 || hcPoolGetString(pool, longstr) != temp)
+  {
+    puts("FAILED adding strings after mark.");
+    return (0);
+  }
+
+  hcPoolReset(pool);
+
+  for (i = 0; i < (int)(sizeof(words) / sizeof(words[0])); i ++)
+  {
+    if (hcPoolGetString(pool, words[i]) != strings[i])
+    {
+      printf("FAILED word string #%d ('%s') did not reuse pointer after reset.\n", i + 1, words[i]);
+      return (0);
+    }
+  }
+
+  if (hcPoolGetAtom(pool, "post-mark string") != atom)
+  {
+    puts("FAILED string added after mark was not released by reset.");
+    return (0);
+  }
+
+  hcPoolReset(pool);
+
+  puts("PASSED mark/reset checks.\n");
+
+  return (1);
+}
+
+
+#ifdef HAVE_PTHREAD_H
+//
+// 'test_shared_pool_functions()' - Test shared memory pool functions.
+//
+
+static int				// O - 1 on success, 0 on failure
+test_shared_pool_functions(void)
+{
+  int		i, j;			// Looping vars
+  hc_pool_t	*pool;			// Shared memory pool
+  pthread_t	threads[4];		// Threads
+  shared_test_t	data[4];		// Thread data
+  char		s[32];			// String
+
+
+  puts("Testing shared memory pool functions:\n");
+
+  if ((pool = hcPoolNewShared("testhtmlcss")) == NULL)
+  {
+    puts("FAILED creating shared memory pool.");
+    return (0);
+  }
+
+  hcPoolSetErrorCallback(pool, error_cb, NULL);
+
+  for (i = 0; i < 4; i ++)
+  {
+    data[i].pool    = pool;
+    data[i].reverse = (i & 1) != 0;	// Collide with the other threads
+
+    if (pthread_create(threads + i, NULL, (void *(*)(void *))shared_pool_thread, data + i))
+    {
+      puts("FAILED creating thread.");
+      return (0);
+    }
+  }
+
+  for (i = 0; i < 4; i ++)
+    pthread_join(threads[i], NULL);
+
+  printf("PASSED adding strings from %d threads.\n", i);
+
+  for (i = 0; i < 1000; i ++)
+  {
+    snprintf(s, sizeof(s), "Shared-%d", i);
+
+    if (!data[0].strings[i] || strcmp(data[0].strings[i], s) || hcPoolAtomString(pool, data[0].atoms[i]) != data[0].strings[i])
+    {
+      printf("FAILED verifying shared string #%d ('%s')\n", i + 1, s);
+      return (0);
+    }
+
+    for (j = 1; j < 4; j ++)
+    {
+      if (data[j].strings[i] != data[0].strings[i] || data[j].atoms[i] != data[0].atoms[i])
+      {
+        printf("FAILED shared string #%d ('%s') differs between threads.\n", i + 1, s);
+        return (0);
+      }
+    }
+
+    s[0] = 's';
+
+    if (hcPoolAtomLower(pool, data[0].atoms[i]) != hcPoolGetAtom(pool, s))
+    {
+      printf("FAILED verifying lowercase shared string #%d ('%s')\n", i + 1, s);
+      return (0);
+    }
+  }
+
+  printf("PASSED verifying %d shared strings.\n", i);
+
+  // Each thread keeps its own error message after it exits...
+  for (i = 0; i < 4; i ++)
+  {
+    snprintf(s, sizeof(s), "Thread error %p.", (void *)(data + i));
+
+    if (!data[i].last_error || strcmp(data[i].last_error, s))
+    {
+      printf("FAILED getting last error for thread %d, got \"%s\".\n", i + 1, data[i].last_error ? data[i].last_error : "(null)");
+      return (0);
+    }
+  }
+
+  _hcPoolError(pool, 0, "Test error.");
+  if (!hcPoolGetLastError(pool) || strcmp(hcPoolGetLastError(pool), "Test error."))
+  {
+    puts("FAILED getting last error from shared memory pool.");
+    return (0);
+  }
+
+  hcPoolDelete(pool);
+
+  puts("PASSED shared memory pool checks.\n");
 
   return (1);
 }
+#endif // HAVE_PTHREAD_H
 
 
 //
@@ -795,3 +2483,42 @@ test_sha3_functions(void)
   return (status);
 }
 
+
+//
+// 'url_cb()' - URL callback for testing the URL cache.
+//
+
+static char *				// O - Local filename or `NULL`
+url_cb(void       *ctx,			// I - Pointer to callback count
+       const char *url,			// I - URL
+       char       *buffer,		// I - Filename buffer
+       size_t     bufsize)		// I - Size of filename buffer
+{
+  const char	*ptr;			// Pointer into URL
+
+
+  (*(int *)ctx) ++;
+
+  if ((ptr = strrchr(url, '/')) != NULL && !strcmp(ptr, "/basic.html"))
+  {
+    // Map to a real file for the cache directory tests...
+    snprintf(buffer, bufsize, "testsuite%s", ptr);
+    return (buffer);
+  }
+  else if (!strncmp(url, "https://cache.example.com", 25))
+  {
+    // Map everything on the cache test server to a real file...
+    strncpy(buffer, "testsuite/basic.html", bufsize - 1);
+    buffer[bufsize - 1] = '\0';
+    return (buffer);
+  }
+  else if (!ptr || strcmp(ptr, "/found.html"))
+  {
+    return (NULL);
+  }
+
+  strncpy(buffer, ptr + 1, bufsize - 1);
+  buffer[bufsize - 1] = '\0';
+
+  return (buffer);
+}